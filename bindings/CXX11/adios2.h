@@ -31,6 +31,7 @@ constexpr bool DebugOFF = false;
 #include "adios2/cxx11/IO.h"
 #include "adios2/cxx11/Operator.h"
 #include "adios2/cxx11/Query.h"
+#include "adios2/cxx11/ReadPlan.h"
 #include "adios2/cxx11/Types.h"
 #include "adios2/cxx11/Variable.h"
 #include "adios2/cxx11/fstream/ADIOS2fstream.h"
@@ -97,6 +97,40 @@ void Engine::PerformGets()
     m_Engine->PerformGets();
 }
 
+std::future<void> Engine::PerformGetsAsync()
+{
+    helper::CheckForNullptr(m_Engine, "in call to Engine::PerformGetsAsync");
+    if (m_Engine->m_EngineType == "NULL")
+    {
+        std::promise<void> done;
+        done.set_value();
+        return done.get_future();
+    }
+    return m_Engine->PerformGetsAsync();
+}
+
+void Engine::Get(const ReadPlan &plan)
+{
+    helper::CheckForNullptr(m_Engine, "in call to Engine::Get(ReadPlan)");
+    if (m_Engine->m_EngineType == "NULL")
+    {
+        return;
+    }
+    plan.Execute(*this);
+}
+
+std::future<void> Engine::GetAsync(const ReadPlan &plan)
+{
+    helper::CheckForNullptr(m_Engine, "in call to Engine::GetAsync");
+    if (m_Engine->m_EngineType == "NULL")
+    {
+        std::promise<void> done;
+        done.set_value();
+        return done.get_future();
+    }
+    return plan.ExecuteAsync(*this);
+}
+
 void Engine::LockWriterDefinitions()
 {
     helper::CheckForNullptr(m_Engine,
@@ -172,7 +206,8 @@ Engine::Engine(core::Engine *engine) : m_Engine(engine) {}
     template typename Variable<T>::Span Engine::Put(Variable<T>, const bool,   \
                                                     const T &);                \
     template typename Variable<T>::Span Engine::Put(Variable<T>);              \
-    template void Engine::Get<T>(Variable<T>, T **) const;
+    template void Engine::Get<T>(Variable<T>, T **) const;                     \
+    template void Engine::Get<T>(Variable<T>, T **, Box<Dims> &) const;
 
 ADIOS2_FOREACH_PRIMITIVE_TYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
@@ -11,6 +11,9 @@
 #ifndef ADIOS2_BINDINGS_CXX11_CXX11_ENGINE_H_
 #define ADIOS2_BINDINGS_CXX11_CXX11_ENGINE_H_
 
+#include <future>
+
+#include "ReadPlan.h"
 #include "Types.h"
 #include "Variable.h"
 
@@ -359,9 +362,46 @@ public:
     template <class T>
     void Get(Variable<T> variable, T **data) const;
 
+    /**
+     * Get(variable, data) that also returns the start and count of the block
+     * data points into. The selection has the strides of that block's count.
+     * Only for the inline engine.
+     */
+    template <class T>
+    void Get(Variable<T> variable, T **data, Box<Dims> &block) const;
+
     /** Perform all Get calls in Deferred mode up to this point */
     void PerformGets();
 
+    /**
+     * Starts all Get calls in Deferred mode up to this point and returns
+     * without waiting for the data, which BP5 and SST (BP5 marshaling) read
+     * on a background thread. Until the returned future is ready the engine
+     * may only be used for Get, PerformGets, PerformGetsAsync, EndStep and
+     * Close, which wait for it.
+     * @return ready when the data is in place, its get() rethrows read errors
+     */
+    std::future<void> PerformGetsAsync();
+
+    /**
+     * Executes all reads of plan: identical requests are read once and a
+     * single PerformGets is issued, this also performs any Get called in
+     * Deferred mode before. Data is available when this returns.
+     * @param plan reads to be executed
+     */
+    void Get(const ReadPlan &plan);
+
+    /**
+     * Queues the reads of plan like Get(plan) and starts them with
+     * PerformGetsAsync, with the same restrictions on the use of the engine
+     * until the data is in place. Requests identical to another one are
+     * filled when get() or wait() is called on the returned future.
+     * @param plan reads to be executed, only used during this call
+     * @return ready when all data of plan is available, its get() rethrows
+     * any exception raised by the reads
+     */
+    std::future<void> GetAsync(const ReadPlan &plan);
+
     /**
      * Ends current step, by default calls PerformsPut/Get internally
      * Check each engine documentation for MPI collective/non-collective
@@ -1,4 +1,5 @@
 #include "Query.h"
+#include "adios2/common/ADIOSMacros.h"
 #include "adios2/toolkit/query/Worker.h"
 
 #include <utility>
@@ -22,4 +23,39 @@ void QueryWorker::GetResultCoverage(
     if (m_Worker)
         return m_Worker->GetResultCoverage(outputSelection, touched_blocks);
 }
+
+void QueryWorker::GetResultCoverage(
+    const adios2::Box<adios2::Dims> &outputSelection, const size_t firstStep,
+    const size_t nSteps,
+    std::vector<std::vector<adios2::Box<adios2::Dims>>> &touched_blocks,
+    const unsigned int nThreads)
+{
+    if (m_Worker)
+        m_Worker->GetResultCoverage(outputSelection, firstStep, nSteps,
+                                    touched_blocks, nThreads);
+}
+
+void QueryWorker::GetResultHits(
+    std::vector<adios2::Box<adios2::Dims>> &touched_blocks,
+    std::vector<std::vector<size_t>> &hits)
+{
+    if (m_Worker)
+        m_Worker->GetResultHits(touched_blocks, hits);
+}
+
+template <class T>
+void QueryWorker::GetResultValues(
+    std::vector<adios2::Box<adios2::Dims>> &touched_blocks,
+    std::vector<std::vector<size_t>> &hits, std::vector<T> &values)
+{
+    if (m_Worker)
+        m_Worker->GetResultValues(touched_blocks, hits, values);
+}
+
+#define declare_template_instantiation(T)                                      \
+    template void QueryWorker::GetResultValues(                                \
+        std::vector<adios2::Box<adios2::Dims>> &,                              \
+        std::vector<std::vector<size_t>> &, std::vector<T> &);
+ADIOS2_FOREACH_ATTRIBUTE_PRIMITIVE_STDTYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
 }
@@ -32,6 +32,45 @@ public:
     GetResultCoverage(adios2::Box<adios2::Dims> &,
                       std::vector<adios2::Box<adios2::Dims>> &touched_blocks);
 
+    /**
+     * Evaluates the query for steps [firstStep, firstStep + nSteps) of an
+     * engine opened for random access (ReadRandomAccess for BP5, Read for
+     * BP3/BP4 without BeginStep). Steps are spread over the engine's
+     * communicator and nThreads threads per process, every process receives
+     * the coverage of all steps. Collective over the engine's communicator.
+     * @param outputSelection as in the single step version
+     * @param firstStep absolute step to start with
+     * @param nSteps number of steps, clipped to the available steps
+     * @param touched_blocks touched_blocks[i] is the coverage of
+     * firstStep + i
+     * @param nThreads threads per process evaluating steps
+     */
+    void GetResultCoverage(
+        const adios2::Box<adios2::Dims> &outputSelection,
+        const size_t firstStep, const size_t nSteps,
+        std::vector<std::vector<adios2::Box<adios2::Dims>>> &touched_blocks,
+        const unsigned int nThreads = 1);
+
+    /**
+     * Element level result for the current step: regions touched by the
+     * query are read and every element is checked. Regions and offsets are
+     * in the variable's global coordinates.
+     * @param touched_blocks regions with at least one matching element
+     * @param hits hits[i] are the row-major offsets within touched_blocks[i]
+     * of the matching elements
+     */
+    void GetResultHits(std::vector<adios2::Box<adios2::Dims>> &touched_blocks,
+                       std::vector<std::vector<size_t>> &hits);
+
+    /**
+     * GetResultHits that also returns the matching values in hit order.
+     * Only for a query on a single variable of type T.
+     */
+    template <class T>
+    void GetResultValues(std::vector<adios2::Box<adios2::Dims>> &touched_blocks,
+                         std::vector<std::vector<size_t>> &hits,
+                         std::vector<T> &values);
+
 private:
     std::shared_ptr<adios2::query::Worker> m_Worker;
 }; // class QueryWorker
@@ -0,0 +1,137 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * ReadPlan.cpp :
+ */
+
+#include "ReadPlan.h"
+#include "ReadPlan.tcc"
+
+#include <memory>  // std::make_shared
+#include <numeric> // std::iota
+#include <tuple>   // std::tie
+#include <utility> // std::pair
+
+namespace adios2
+{
+
+size_t ReadPlan::Size() const noexcept { return m_Requests.size(); }
+
+void ReadPlan::Clear() noexcept { m_Requests.clear(); }
+
+namespace
+{
+
+/** restores the selections saved before the reads were queued, the last
+ * saved first, so each variable gets its original selection back */
+struct SelectionRestorer
+{
+    std::vector<std::pair<core::VariableBase *, SelectionState>> Saved;
+
+    void Save(core::VariableBase *variable)
+    {
+        Saved.emplace_back(variable, SelectionState(*variable));
+    }
+
+    ~SelectionRestorer()
+    {
+        for (auto it = Saved.rbegin(); it != Saved.rend(); ++it)
+        {
+            it->second.ApplyTo(*it->first);
+        }
+    }
+};
+
+} // end empty namespace
+
+std::vector<ReadPlan::Duplicate>
+ReadPlan::Queue(Engine &engine,
+                const std::function<void(core::VariableBase *)> &save) const
+{
+    // step first, the data of a step is stored together
+    auto lf_Key = [](const Request &r) {
+        return std::tie(r.StepStart, r.Name, r.StepCount, r.IsBlock, r.BlockID,
+                        r.Start, r.Count);
+    };
+
+    std::vector<size_t> order(m_Requests.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](const size_t a, const size_t b) {
+                         return lf_Key(m_Requests[a]) < lf_Key(m_Requests[b]);
+                     });
+
+    std::vector<Duplicate> duplicates;
+    const Request *previous = nullptr;
+    size_t previousElements = 0;
+    for (const size_t i : order)
+    {
+        const Request &request = m_Requests[i];
+        if (previous != nullptr && lf_Key(*previous) == lf_Key(request))
+        {
+            duplicates.push_back({previous->Destination, request.Destination,
+                                  previousElements, request.Copy});
+            continue;
+        }
+        save(request.Variable);
+        previousElements = request.Queue(engine, request.Destination);
+        previous = &request;
+    }
+    return duplicates;
+}
+
+void ReadPlan::FillDuplicates(const std::vector<Duplicate> &duplicates)
+{
+    for (const Duplicate &duplicate : duplicates)
+    {
+        if (duplicate.Target != duplicate.Source)
+        {
+            duplicate.Copy(duplicate.Source, duplicate.Target,
+                           duplicate.Elements);
+        }
+    }
+}
+
+void ReadPlan::Execute(Engine &engine) const
+{
+    SelectionRestorer restorer;
+    const std::vector<Duplicate> duplicates =
+        Queue(engine, [&](core::VariableBase *v) { restorer.Save(v); });
+    engine.PerformGets();
+    FillDuplicates(duplicates);
+}
+
+std::future<void> ReadPlan::ExecuteAsync(Engine &engine) const
+{
+    std::vector<Duplicate> duplicates;
+    std::future<void> reads;
+    {
+        SelectionRestorer restorer;
+        duplicates =
+            Queue(engine, [&](core::VariableBase *v) { restorer.Save(v); });
+        // takes what it needs from the queued reads before returning, the
+        // selections can be restored while the data is being read
+        reads = engine.PerformGetsAsync();
+    }
+    if (duplicates.empty())
+    {
+        return reads;
+    }
+    auto pending = std::make_shared<std::future<void>>(std::move(reads));
+    return std::async(std::launch::deferred, [pending, duplicates]() {
+        pending->get();
+        FillDuplicates(duplicates);
+    });
+}
+
+#define declare_template_instantiation(T)                                      \
+    template void ReadPlan::Add(Variable<T>, T *, const Box<Dims> &,           \
+                                const Box<size_t> &);                          \
+    template void ReadPlan::AddBlock(Variable<T>, const size_t, T *,           \
+                                     const Box<size_t> &);
+
+ADIOS2_FOREACH_TYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+
+} // end namespace adios2
@@ -0,0 +1,138 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * ReadPlan.h : a set of reads executed together by Engine::Get(ReadPlan)
+ */
+
+#ifndef ADIOS2_BINDINGS_CXX11_CXX11_READPLAN_H_
+#define ADIOS2_BINDINGS_CXX11_CXX11_READPLAN_H_
+
+#include <functional>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "Variable.h"
+
+#include "adios2/common/ADIOSMacros.h"
+#include "adios2/common/ADIOSTypes.h"
+
+namespace adios2
+{
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+// forward declare
+class Engine; // friend
+/// \endcond
+
+/**
+ * List of (variable, step range, selection, destination) reads. Executing a
+ * plan with Engine::Get or Engine::GetAsync queues all reads ordered by step
+ * and variable, reads identical requests only once and issues a single
+ * PerformGets, so that the engine can merge the I/O of the whole plan.
+ * Each read uses the selection the variable had when it was added, with the
+ * given parts replaced. The selections of the variables are restored when
+ * Engine::Get or Engine::GetAsync returns.
+ */
+class ReadPlan
+{
+    friend class Engine;
+
+public:
+    ReadPlan() = default;
+
+    ~ReadPlan() = default;
+
+    /**
+     * Adds a read of variable into destination
+     * @param variable variable from IO::InquireVariable
+     * @param destination memory for the selection, must stay valid until
+     * the plan is executed
+     * @param selection {start, count}, empty keeps the variable's current
+     * selection
+     * @param stepSelection {stepStart, stepCount}, stepCount = 0 keeps the
+     * variable's current step selection
+     */
+    template <class T>
+    void Add(Variable<T> variable, T *destination,
+             const Box<Dims> &selection = Box<Dims>(),
+             const Box<size_t> &stepSelection = Box<size_t>(0, 0));
+
+    /**
+     * Adds a read of a single block of variable into destination
+     * @param variable variable from IO::InquireVariable
+     * @param blockID block to be read, as in Variable::SetBlockSelection
+     * @param destination memory for the block, must stay valid until the
+     * plan is executed
+     * @param stepSelection {stepStart, stepCount}, stepCount = 0 keeps the
+     * variable's current step selection
+     */
+    template <class T>
+    void AddBlock(Variable<T> variable, const size_t blockID, T *destination,
+                  const Box<size_t> &stepSelection = Box<size_t>(0, 0));
+
+    /** @return number of reads in the plan */
+    size_t Size() const noexcept;
+
+    /** Removes all reads from the plan */
+    void Clear() noexcept;
+
+private:
+    struct Request
+    {
+        std::string Name;
+        size_t StepStart = 0;
+        size_t StepCount = 0;
+        bool IsBlock = false;
+        size_t BlockID = 0;
+        Dims Start;
+        Dims Count;
+        void *Destination = nullptr;
+        /** variable whose selection is changed to queue the read */
+        core::VariableBase *Variable = nullptr;
+        /** sets the whole selection and queues a deferred Get into
+         * destination, returns the number of elements it reads */
+        std::function<size_t(Engine &, void *)> Queue;
+        /** copies a number of elements between destinations */
+        std::function<void(const void *, void *, size_t)> Copy;
+    };
+
+    /** an identical request, filled from the first one after the reads */
+    struct Duplicate
+    {
+        const void *Source;
+        void *Target;
+        size_t Elements;
+        std::function<void(const void *, void *, size_t)> Copy;
+    };
+
+    std::vector<Request> m_Requests;
+
+    /** queues all reads on engine, calling save with each variable before
+     * changing its selection */
+    std::vector<Duplicate>
+    Queue(Engine &engine,
+          const std::function<void(core::VariableBase *)> &save) const;
+
+    static void FillDuplicates(const std::vector<Duplicate> &duplicates);
+
+    /** queues all reads and calls PerformGets on engine */
+    void Execute(Engine &engine) const;
+
+    /** queues all reads and calls PerformGetsAsync on engine */
+    std::future<void> ExecuteAsync(Engine &engine) const;
+};
+
+#define declare_template_instantiation(T)                                      \
+    extern template void ReadPlan::Add(Variable<T>, T *, const Box<Dims> &,    \
+                                       const Box<size_t> &);                   \
+    extern template void ReadPlan::AddBlock(Variable<T>, const size_t, T *,    \
+                                            const Box<size_t> &);
+
+ADIOS2_FOREACH_TYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+
+} // end namespace adios2
+
+#endif /* ADIOS2_BINDINGS_CXX11_CXX11_READPLAN_H_ */
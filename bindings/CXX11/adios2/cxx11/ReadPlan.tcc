@@ -0,0 +1,139 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * ReadPlan.tcc :
+ */
+
+#ifndef ADIOS2_BINDINGS_CXX11_CXX11_READPLAN_TCC_
+#define ADIOS2_BINDINGS_CXX11_CXX11_READPLAN_TCC_
+
+#include "ReadPlan.h"
+
+#include <algorithm>
+
+#include "Engine.h"
+#include "adios2/core/Variable.h"
+
+namespace adios2
+{
+
+namespace
+{
+
+template <class T>
+void CopyElements(const void *source, void *destination, size_t count)
+{
+    std::copy_n(static_cast<const T *>(source), count,
+                static_cast<T *>(destination));
+}
+
+/** everything the Set*Selection calls change in a variable */
+struct SelectionState
+{
+    SelectionType Type;
+    size_t BlockID;
+    Dims Start;
+    Dims Count;
+    size_t StepsStart;
+    size_t StepsCount;
+    bool RandomAccess;
+    Dims Shape;
+
+    explicit SelectionState(const core::VariableBase &variable)
+    : Type(variable.m_SelectionType), BlockID(variable.m_BlockID),
+      Start(variable.m_Start), Count(variable.m_Count),
+      StepsStart(variable.m_StepsStart), StepsCount(variable.m_StepsCount),
+      RandomAccess(variable.m_RandomAccess), Shape(variable.m_Shape)
+    {
+    }
+
+    void ApplyTo(core::VariableBase &variable) const
+    {
+        variable.m_SelectionType = Type;
+        variable.m_BlockID = BlockID;
+        variable.m_Start = Start;
+        variable.m_Count = Count;
+        variable.m_StepsStart = StepsStart;
+        variable.m_StepsCount = StepsCount;
+        variable.m_RandomAccess = RandomAccess;
+        variable.m_Shape = Shape;
+    }
+};
+
+} // end empty namespace
+
+template <class T>
+void ReadPlan::Add(Variable<T> variable, T *destination,
+                   const Box<Dims> &selection, const Box<size_t> &stepSelection)
+{
+    // the selection when added is the base of the read
+    const SelectionState state(*variable.m_Variable);
+    const bool hasSelection =
+        !selection.first.empty() || !selection.second.empty();
+    const bool hasSteps = stepSelection.second > 0;
+
+    Request request;
+    request.Name = variable.Name();
+    request.StepStart = hasSteps ? stepSelection.first : state.StepsStart;
+    request.StepCount = hasSteps ? stepSelection.second : state.StepsCount;
+    request.IsBlock = !hasSelection && state.Type == SelectionType::WriteBlock;
+    request.BlockID = request.IsBlock ? state.BlockID : 0;
+    request.Start = hasSelection ? selection.first : state.Start;
+    request.Count = hasSelection ? selection.second : state.Count;
+    request.Destination = destination;
+    request.Variable = variable.m_Variable;
+    request.Queue = [variable, state, hasSelection, selection, hasSteps,
+                     stepSelection](Engine &engine,
+                                    void *data) mutable -> size_t {
+        state.ApplyTo(*variable.m_Variable);
+        if (hasSteps)
+        {
+            variable.SetStepSelection(stepSelection);
+        }
+        if (hasSelection)
+        {
+            variable.SetSelection(selection);
+        }
+        engine.Get(variable, static_cast<T *>(data), Mode::Deferred);
+        return variable.SelectionSize();
+    };
+    request.Copy = CopyElements<T>;
+    m_Requests.push_back(std::move(request));
+}
+
+template <class T>
+void ReadPlan::AddBlock(Variable<T> variable, const size_t blockID,
+                        T *destination, const Box<size_t> &stepSelection)
+{
+    const SelectionState state(*variable.m_Variable);
+    const bool hasSteps = stepSelection.second > 0;
+
+    Request request;
+    request.Name = variable.Name();
+    request.StepStart = hasSteps ? stepSelection.first : state.StepsStart;
+    request.StepCount = hasSteps ? stepSelection.second : state.StepsCount;
+    request.IsBlock = true;
+    request.BlockID = blockID;
+    request.Start = state.Start;
+    request.Count = state.Count;
+    request.Destination = destination;
+    request.Variable = variable.m_Variable;
+    request.Queue = [variable, state, blockID, hasSteps, stepSelection](
+                        Engine &engine, void *data) mutable -> size_t {
+        state.ApplyTo(*variable.m_Variable);
+        variable.SetBlockSelection(blockID);
+        if (hasSteps)
+        {
+            variable.SetStepSelection(stepSelection);
+        }
+        engine.Get(variable, static_cast<T *>(data), Mode::Deferred);
+        return variable.SelectionSize();
+    };
+    request.Copy = CopyElements<T>;
+    m_Requests.push_back(std::move(request));
+}
+
+} // end namespace adios2
+
+#endif /* ADIOS2_BINDINGS_CXX11_CXX11_READPLAN_TCC_ */
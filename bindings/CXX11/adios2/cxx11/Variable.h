@@ -20,9 +20,10 @@ namespace adios2
 
 /// \cond EXCLUDE_FROM_DOXYGEN
 // forward declare
-class IO;     // friend
-class Engine; // friend
-class Group;  // friend
+class IO;       // friend
+class Engine;   // friend
+class Group;    // friend
+class ReadPlan; // friend
 namespace core
 {
 
@@ -134,6 +135,7 @@ class Variable
     friend class IO;
     friend class Engine;
     friend class Group;
+    friend class ReadPlan;
 
 public:
     /**
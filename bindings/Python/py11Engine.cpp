@@ -12,6 +12,8 @@
 
 #include "adios2/common/ADIOSMacros.h"
 #include "adios2/core/Engine.h"
+#include "adios2/engine/inline/InlineReader.h"
+#include "adios2/engine/inline/InlineWriter.h"
 #include "adios2/helper/adiosFunctions.h"
 
 #include <sstream>
@@ -23,6 +25,105 @@ namespace adios2
 namespace py11
 {
 
+namespace
+{
+
+/** new numpy array shaped like the selection of variable, with a leading
+ * steps dimension if more than one step is selected */
+template <class T>
+pybind11::array_t<T> SelectionArray(const core::Variable<T> &variable)
+{
+    Dims shapePy;
+    if (variable.m_StepsCount > 1)
+    {
+        shapePy.push_back(variable.m_StepsCount);
+    }
+    const Dims count = variable.Count();
+    shapePy.insert(shapePy.end(), count.begin(), count.end());
+    return pybind11::array_t<T>(shapePy);
+}
+
+/** block of the current step the selection of variable lies in, or nullptr */
+template <class T>
+const typename core::Variable<T>::BPInfo *
+SelectionBlock(const core::Variable<T> &variable,
+               const std::vector<typename core::Variable<T>::BPInfo> &blocks)
+{
+    if (variable.m_ShapeID == ShapeID::LocalArray ||
+        variable.m_SelectionType == SelectionType::WriteBlock)
+    {
+        return variable.m_BlockID < blocks.size()
+                   ? &blocks[variable.m_BlockID]
+                   : nullptr;
+    }
+    if (variable.m_ShapeID != ShapeID::GlobalArray)
+    {
+        return blocks.empty() ? nullptr : &blocks.back();
+    }
+
+    const Dims &start = variable.m_Start;
+    const Dims &count = variable.m_Count;
+    for (const auto &info : blocks)
+    {
+        bool contained = info.Start.size() == start.size();
+        for (size_t d = 0; contained && d < start.size(); ++d)
+        {
+            contained = info.Start[d] <= start[d] &&
+                        start[d] + count[d] <= info.Start[d] + info.Count[d];
+        }
+        if (contained)
+        {
+            return &info;
+        }
+    }
+    return nullptr;
+}
+
+template <class T>
+pybind11::array DoGetView(core::Engine &engine, core::Variable<T> &variable)
+{
+    auto *reader = dynamic_cast<core::engine::InlineReader *>(&engine);
+    if (reader != nullptr && reader->IsInsideStep() &&
+        variable.m_StepsCount <= 1)
+    {
+        const auto blocks = engine.BlocksInfo(variable, engine.CurrentStep());
+        if (SelectionBlock(variable, blocks) != nullptr)
+        {
+            T *data = nullptr;
+            Box<Dims> block;
+            reader->Get(variable, &data, &block);
+
+            // the view is strided like the block it lies in, row-major
+            const Dims count = variable.Count();
+            std::vector<pybind11::ssize_t> strides(count.size(), sizeof(T));
+            for (size_t d = count.size(); d-- > 1;)
+            {
+                strides[d - 1] = strides[d] * block.second[d];
+            }
+
+            // the view holds the step, which holds the arrays put by a
+            // Python writer, so its memory outlives EndStep
+            auto *step = new std::shared_ptr<core::engine::InlineStep>(
+                reader->ActiveStep());
+            pybind11::capsule owner(step, [](void *p) {
+                delete static_cast<
+                    std::shared_ptr<core::engine::InlineStep> *>(p);
+            });
+            pybind11::array_t<T> view(count, strides, data, owner);
+            // the data belongs to the writer
+            pybind11::detail::array_proxy(view.ptr())->flags &=
+                ~pybind11::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+            return std::move(view);
+        }
+    }
+
+    pybind11::array_t<T> pyArray = SelectionArray(variable);
+    engine.Get(variable, pyArray.mutable_data(), Mode::Sync);
+    return std::move(pyArray);
+}
+
+} // end anonymous namespace
+
 Engine::Engine(core::Engine *engine) : m_Engine(engine) {}
 
 Engine::operator bool() const noexcept
@@ -90,6 +191,17 @@ void Engine::Put(Variable variable, const pybind11::array &array,
                                     "is not memory contiguous "
                                     ", in call to Put\n");
     }
+
+    // inline readers point into the array, it lives as long as their steps
+    auto *writer = dynamic_cast<core::engine::InlineWriter *>(m_Engine);
+    if (writer != nullptr)
+    {
+        writer->KeepAlive(std::shared_ptr<void>(
+            new pybind11::object(array), [](void *p) {
+                pybind11::gil_scoped_acquire gil;
+                delete static_cast<pybind11::object *>(p);
+            }));
+    }
 }
 
 void Engine::Put(Variable variable, const std::string &string)
@@ -197,6 +309,100 @@ std::string Engine::Get(Variable variable, const Mode launch)
     }
     return string;
 }
+pybind11::array Engine::GetView(Variable variable)
+{
+    helper::CheckForNullptr(m_Engine, "for engine, in call to Engine::GetView");
+    if (m_Engine->m_EngineType == "NULL")
+    {
+        return pybind11::array();
+    }
+
+    helper::CheckForNullptr(variable.m_VariableBase,
+                            "for variable, in call to Engine::GetView");
+
+    const adios2::DataType type =
+        helper::GetDataTypeFromString(variable.Type());
+
+    if (type == adios2::DataType::Compound)
+    {
+        // not supported
+    }
+#define declare_type(T)                                                        \
+    else if (type == helper::GetDataType<T>())                                 \
+    {                                                                          \
+        return DoGetView(                                                      \
+            *m_Engine,                                                         \
+            *dynamic_cast<core::Variable<T> *>(variable.m_VariableBase));      \
+    }
+    ADIOS2_FOREACH_NUMPY_TYPE_1ARG(declare_type)
+#undef declare_type
+    else
+    {
+        throw std::invalid_argument("ERROR: variable " + variable.Name() +
+                                    " of type " + variable.Type() +
+                                    " can't be mapped to a numpy type, in "
+                                    "call to Engine::GetView\n");
+    }
+    return pybind11::array();
+}
+
+std::vector<pybind11::array>
+Engine::GetBatch(const std::vector<std::tuple<Variable, Dims, Dims>> &requests)
+{
+    std::vector<pybind11::array> arrays;
+    helper::CheckForNullptr(m_Engine,
+                            "for engine, in call to Engine::GetBatch");
+    if (m_Engine->m_EngineType == "NULL")
+    {
+        return arrays;
+    }
+
+    arrays.reserve(requests.size());
+    for (const auto &request : requests)
+    {
+        const Variable &variable = std::get<0>(request);
+        const Dims &start = std::get<1>(request);
+        const Dims &count = std::get<2>(request);
+
+        helper::CheckForNullptr(variable.m_VariableBase,
+                                "for variable, in call to Engine::GetBatch");
+        if (!start.empty() || !count.empty())
+        {
+            variable.m_VariableBase->SetSelection({start, count});
+        }
+
+        const adios2::DataType type =
+            helper::GetDataTypeFromString(variable.Type());
+
+        if (type == adios2::DataType::Compound)
+        {
+            // not supported
+        }
+#define declare_type(T)                                                        \
+    else if (type == helper::GetDataType<T>())                                 \
+    {                                                                          \
+        auto &coreVariable =                                                   \
+            *dynamic_cast<core::Variable<T> *>(variable.m_VariableBase);       \
+        pybind11::array_t<T> pyArray = SelectionArray(coreVariable);           \
+        m_Engine->Get(coreVariable, pyArray.mutable_data(), Mode::Deferred);   \
+        arrays.push_back(std::move(pyArray));                                  \
+    }
+        ADIOS2_FOREACH_NUMPY_TYPE_1ARG(declare_type)
+#undef declare_type
+        else
+        {
+            throw std::invalid_argument("ERROR: variable " + variable.Name() +
+                                        " of type " + variable.Type() +
+                                        " can't be mapped to a numpy type, in "
+                                        "call to Engine::GetBatch\n");
+        }
+    }
+
+    // the arrays are only filled once all requests are queued
+    m_Engine->PerformGets();
+    return arrays;
+}
+
 void Engine::PerformGets()
 {
     helper::CheckForNullptr(m_Engine, "in call to Engine::PerformGets");
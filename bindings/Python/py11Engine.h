@@ -14,6 +14,8 @@
 #include <pybind11/numpy.h>
 
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include "adios2/core/Engine.h"
 
@@ -58,6 +60,24 @@ public:
              const Mode launch = Mode::Deferred);
     std::string Get(Variable variable, const Mode launch = Mode::Deferred);
 
+    /**
+     * Returns the current selection of variable as a numpy array. Inside a
+     * step of an Inline reader, if the selection lies in a single block, the
+     * array is a read-only view of that block. The view holds the step, and
+     * with it the arrays put by a Python writer, so it never dangles, but the
+     * writer may change the data once the step has ended. Otherwise the
+     * selection is read into a new array.
+     */
+    pybind11::array GetView(Variable variable);
+
+    /**
+     * Reads a list of (variable, start, count) requests with a single
+     * PerformGets, one new array per request. Empty start and count keep the
+     * variable's current selection.
+     */
+    std::vector<pybind11::array>
+    GetBatch(const std::vector<std::tuple<Variable, Dims, Dims>> &requests);
+
     void PerformGets();
 
     void EndStep();
@@ -489,6 +489,12 @@ PYBIND11_MODULE(ADIOS2_PYTHON_MODULE_NAME, m)
              pybind11::arg("variable"),
              pybind11::arg("launch") = adios2::Mode::Deferred)
 
+        .def("GetView", &adios2::py11::Engine::GetView,
+             pybind11::arg("variable"))
+
+        .def("GetBatch", &adios2::py11::Engine::GetBatch,
+             pybind11::arg("requests"))
+
         .def("PerformGets", &adios2::py11::Engine::PerformGets)
 
         .def("EndStep", &adios2::py11::Engine::EndStep)
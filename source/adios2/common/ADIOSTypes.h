@@ -211,6 +211,10 @@ struct MinBlockInfo
     size_t *Count;
     MinMaxStruct MinMax;
     void *BufferP = NULL;
+    // Sub-block statistics, if the writer recorded them (StatsBlockSize)
+    size_t *SubBlockDivs = NULL; // divisions of each dimension [Dims]
+    size_t SubBlockCount = 0;    // product of SubBlockDivs
+    void *SubBlockMinMax = NULL; // Min/Max pairs [2 * SubBlockCount]
 };
 struct MinVarInfo
 {
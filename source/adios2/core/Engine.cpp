@@ -64,6 +64,21 @@ void Engine::EndStep() { ThrowUp("EndStep"); }
 void Engine::PerformPuts() { ThrowUp("PerformPuts"); }
 void Engine::PerformGets() { ThrowUp("PerformGets"); }
 
+std::future<void> Engine::PerformGetsAsync()
+{
+    std::promise<void> done;
+    try
+    {
+        PerformGets();
+        done.set_value();
+    }
+    catch (...)
+    {
+        done.set_exception(std::current_exception());
+    }
+    return done.get_future();
+}
+
 void Engine::Close(const int transportIndex)
 {
     DoClose(transportIndex);
@@ -195,6 +210,36 @@ size_t Engine::DoSteps() const
     return MaxSizeT;
 }
 
+std::future<void> Engine::LaunchAsyncGets(std::function<void()> work)
+{
+    WaitForAsyncGets();
+    auto done = std::make_shared<std::promise<void>>();
+    m_AsyncGets = std::async(std::launch::async, [work, done]() {
+        try
+        {
+            work();
+            done->set_value();
+        }
+        catch (...)
+        {
+            done->set_exception(std::current_exception());
+        }
+    });
+    return done->get_future();
+}
+
+void Engine::WaitForAsyncGets()
+{
+    if (m_AsyncGets.valid())
+    {
+        // errors were handed to the future of PerformGetsAsync
+        m_AsyncGets.get();
+        AsyncGetsDone();
+    }
+}
+
+void Engine::AsyncGetsDone() {}
+
 // PRIVATE
 void Engine::ThrowUp(const std::string function) const
 {
@@ -258,7 +303,8 @@ ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #define declare_template_instantiation(T)                                      \
     template typename Variable<T>::Span &Engine::Put(Variable<T> &,            \
                                                      const bool, const T &);   \
-    template void Engine::Get<T>(core::Variable<T> &, T **) const;
+    template void Engine::Get<T>(core::Variable<T> &, T **, Box<Dims> *)       \
+        const;
 
 ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
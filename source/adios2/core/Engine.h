@@ -17,6 +17,7 @@
 /// \cond EXCLUDE_FROM_DOXYGEN
 #include <float.h>
 #include <functional> //std::function
+#include <future>     //std::future
 #include <limits.h>
 #include <limits> //std::numeric_limits
 #include <memory> //std::shared_ptr
@@ -86,6 +87,13 @@ public:
      */
     Mode OpenMode() const noexcept;
 
+    /**
+     * Communicator the engine was opened with, e.g. for toolkit components
+     * (query) that split work across the engine's ranks
+     * @return reference to the engine's communicator
+     */
+    helper::Comm const &GetComm() const noexcept { return m_Comm; }
+
     StepStatus BeginStep();
 
     /**
@@ -346,8 +354,13 @@ public:
     typename Variable<T>::BPInfo *Get(const std::string &variableName,
                                       const Mode launch = Mode::Deferred);
 
+    /**
+     * Zero-copy Get, only supported by the inline engine.
+     * @param block if not nullptr, receives the start and count of the block
+     * data points into, which gives the strides of the selection
+     */
     template <class T>
-    void Get(core::Variable<T> &, T **) const;
+    void Get(core::Variable<T> &, T **, Box<Dims> *block = nullptr) const;
 
     /**
      * Reader application indicates that no more data will be read from the
@@ -364,6 +377,17 @@ public:
      * PerformGets, BeginStep or Open */
     virtual void PerformGets();
 
+    /**
+     * Starts executing all Get (in deferred launch mode) like PerformGets but
+     * returns without waiting for the data. Until the returned future is
+     * ready the engine and its IO may only be used for Get, PerformGets,
+     * PerformGetsAsync, BeginStep, EndStep and Close, which wait for it
+     * before touching any metadata. Engines without native support perform
+     * the Gets before returning.
+     * @return ready when the data is in place, get() rethrows read errors
+     */
+    virtual std::future<void> PerformGetsAsync();
+
     /**
      * Closes a particular transport, or all if transportIndex = -1 (default).
      * @param transportIndex index returned from IO AddTransport, default (-1) =
@@ -582,6 +606,20 @@ protected:
      */
     bool m_BetweenStepPairs = false;
 
+    /**
+     * Runs work on a background thread for PerformGetsAsync, only one may
+     * run at a time. Its exceptions are reported through the returned future.
+     */
+    std::future<void> LaunchAsyncGets(std::function<void()> work);
+
+    /** Waits for the work of the last LaunchAsyncGets, if any, then calls
+     * AsyncGetsDone on the calling thread */
+    void WaitForAsyncGets();
+
+    /** Finishes the work of PerformGetsAsync that must not run on the
+     * background thread, e.g. metadata cache maintenance */
+    virtual void AsyncGetsDone();
+
 private:
     /** Throw exception by Engine virtual functions not implemented/supported by
      *  a derived  class */
@@ -607,6 +645,9 @@ private:
      */
     void CheckOpenModes(const std::set<Mode> &modes,
                         const std::string hint) const;
+
+    /** background work of the last PerformGetsAsync */
+    std::future<void> m_AsyncGets;
 };
 
 } // end namespace core
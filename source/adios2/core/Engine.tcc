@@ -93,6 +93,8 @@ void Engine::Put(const std::string &variableName, const T &datum,
 template <class T>
 void Engine::Get(Variable<T> &variable, T *data, const Mode launch)
 {
+    // the reads of a PerformGetsAsync may still be using the metadata
+    WaitForAsyncGets();
     CommonChecks(variable, data, {{Mode::Read}, {Mode::ReadRandomAccess}},
                  "in call to Get");
 
@@ -134,19 +136,20 @@ template <class T>
 void Engine::Get(Variable<T> &variable, std::vector<T> &dataV,
                  const Mode launch)
 {
+    WaitForAsyncGets();
     const size_t dataSize = variable.SelectionSize();
     helper::Resize(dataV, dataSize, "in call to Get with std::vector argument");
     Get(variable, dataV.data(), launch);
 }
 
 template <class T>
-void Engine::Get(core::Variable<T> &variable, T **data) const
+void Engine::Get(core::Variable<T> &variable, T **data, Box<Dims> *block) const
 {
     const auto *eng =
         dynamic_cast<const adios2::core::engine::InlineReader *>(this);
     if (eng)
     {
-        eng->Get(variable, data);
+        eng->Get(variable, data, block);
     }
     else
     {
@@ -170,6 +173,7 @@ template <class T>
 typename Variable<T>::BPInfo *Engine::Get(Variable<T> &variable,
                                           const Mode launch)
 {
+    WaitForAsyncGets();
     typename Variable<T>::BPInfo *info = nullptr;
     switch (launch)
     {
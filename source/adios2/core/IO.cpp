@@ -614,8 +614,7 @@ Engine &IO::Open(const std::string &name, const Mode mode, helper::Comm comm)
         // only BP5 special-cases file-reader random access mode
         mode_to_use = Mode::Read;
     }
-    // For the inline engine, there must be exactly 1 reader, and exactly 1
-    // writer.
+    // For the inline engine, there must be exactly 1 writer.
     if (engineTypeLC == "inline")
     {
         if (mode_to_use == Mode::Append)
@@ -633,30 +632,22 @@ Engine &IO::Open(const std::string &name, const Mode mode, helper::Comm comm)
                 "Sync mode is not supported in the inline engine.");
         }
 
-        if (m_Engines.size() >= 2)
+        // Any number of readers can share the writer's data, but there can
+        // only be one writer.
+        if (mode_to_use == Mode::Write)
         {
-            std::string msg =
-                "Failed to add engine " + name + " to IO \'" + m_Name + "\'. ";
-            msg += "An inline engine must have exactly one writer, and one "
-                   "reader. ";
-            msg += "There are already two engines declared, so no more can be "
-                   "added.";
-            helper::Throw<std::runtime_error>("Core", "IO", "Open", msg);
-        }
-        // Now protect against declaration of two writers, or declaration of
-        // two readers:
-        if (m_Engines.size() == 1)
-        {
-            auto engine_ptr = m_Engines.begin()->second;
-            if (engine_ptr->OpenMode() == mode_to_use)
+            for (const auto &pair : m_Engines)
             {
-                std::string msg =
-                    "The previously added engine " + engine_ptr->m_Name +
-                    " is already opened in same mode requested for " + name +
-                    ". ";
-                msg += "The inline engine requires exactly one writer and one "
-                       "reader.";
-                helper::Throw<std::runtime_error>("Core", "IO", "Open", msg);
+                if (pair.second->OpenMode() == Mode::Write)
+                {
+                    std::string msg = "The previously added engine " +
+                                      pair.second->m_Name +
+                                      " is already opened in write mode. ";
+                    msg += "The inline engine supports only one writer, " +
+                           name + " can't be added.";
+                    helper::Throw<std::runtime_error>("Core", "IO", "Open",
+                                                      msg);
+                }
             }
         }
     }
@@ -56,9 +56,23 @@ public:
     static constexpr size_t m_BPMinorVersionPosition = 38;
     static constexpr size_t m_ActiveFlagPosition = 39;
     static constexpr size_t m_ColumnMajorFlagPosition = 40;
+    static constexpr size_t m_MetadataDeltaFlagPosition = 41;
     static constexpr size_t m_VersionTagPosition = 0;
     static constexpr size_t m_VersionTagLength = 32;
 
+    /** BP minor versions: 1 is the original layout, 2 adds optional array
+     * metadata fields that minor version 1 readers can't parse (sub-block
+     * statistics), 3 adds delta encoded metadata blocks that refer to a
+     * keyframe (MetadataKeyframeInterval), 4 adds the block checksum
+     * fields (DataChecksum, the "+CK" field name suffix).  Files are written
+     * with the lowest version that holds their content, readers refuse
+     * newer versions. */
+    static constexpr uint8_t m_BPMinorVersionBase = 1;
+    static constexpr uint8_t m_BPMinorVersionStats = 2;
+    static constexpr uint8_t m_BPMinorVersionDelta = 3;
+    static constexpr uint8_t m_BPMinorVersionChecksum = 4;
+    static constexpr uint8_t m_BPMinorVersionMax = 4;
+
     std::vector<std::string>
     GetBPSubStreamNames(const std::vector<std::string> &names,
                         size_t subFileIndex) const noexcept;
@@ -137,10 +151,20 @@ public:
     MACRO(MinDeferredSize, SizeBytes, size_t, DefaultMinDeferredSize)          \
     MACRO(BufferChunkSize, SizeBytes, size_t, DefaultBufferChunkSize)          \
     MACRO(MaxShmSize, SizeBytes, size_t, DefaultMaxShmSize)                    \
+    MACRO(NumShmBuffers, UInt, unsigned int, 2)                                \
     MACRO(BufferVType, BufferVType, int, (int)BufferVType::ChunkVType)         \
     MACRO(AppendAfterSteps, Int, int, INT_MAX)                                 \
     MACRO(SelectSteps, String, std::string, (char *)(intptr_t)0)               \
-    MACRO(ReaderShortCircuitReads, Bool, bool, false)
+    MACRO(ReaderShortCircuitReads, Bool, bool, false)                          \
+    MACRO(StatsBlockSize, SizeBytes, size_t, 0)                                \
+    MACRO(MetadataCacheSteps, UInt, unsigned int, 0)                           \
+    MACRO(NodeSharedMetadata, Bool, bool, false)                               \
+    MACRO(TwoLevelMetadata, Bool, bool, false)                                 \
+    MACRO(MetadataKeyframeInterval, UInt, unsigned int, 0)                     \
+    MACRO(DataChecksum, Bool, bool, false)                                     \
+    MACRO(PrefetchSteps, UInt, unsigned int, 0)                                \
+    MACRO(DecompressedCacheSize, SizeBytes, size_t, 0)                         \
+    MACRO(Threads, UInt, unsigned int, 1)
 
     struct BP5Params
     {
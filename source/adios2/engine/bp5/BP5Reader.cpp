@@ -11,6 +11,8 @@
 
 #include <adios2-perfstubs-interface.h>
 
+#include <algorithm>
+#include <cstring>
 #include <errno.h>
 
 namespace adios2
@@ -32,13 +34,34 @@ BP5Reader::BP5Reader(IO &io, const std::string &name, const Mode mode,
 
 BP5Reader::~BP5Reader()
 {
+    WaitForAsyncGets();
+    WaitForPrefetch();
     if (m_BP5Deserializer)
         delete m_BP5Deserializer;
 }
 
 void BP5Reader::InstallMetadataForTimestep(size_t Step)
 {
-    size_t pgstart = m_MetadataIndexTable[Step][0];
+    char *Buffer = m_SharedMetadata ? m_SharedMetadata
+                                    : m_Metadata.m_Buffer.data();
+    InstallMetadataForTimestep(Step, Buffer, m_MetadataIndexTable[Step][0]);
+}
+
+void BP5Reader::InstallMetadataForTimestep(size_t Step, char *Buffer,
+                                           size_t pgstart, bool Reinstall)
+{
+    if (m_MetadataDeltas)
+    {
+        // expanded blocks of earlier steps are not needed in streaming mode
+        if (m_OpenMode == Mode::ReadRandomAccess)
+        {
+            m_ExpandedMetadata.erase(Step);
+        }
+        else
+        {
+            m_ExpandedMetadata.clear();
+        }
+    }
     size_t Position = pgstart + sizeof(uint64_t); // skip total data size
     const uint64_t WriterCount =
         m_WriterMap[m_WriterMapIndex[Step]].WriterCount;
@@ -46,10 +69,22 @@ void BP5Reader::InstallMetadataForTimestep(size_t Step)
     for (size_t WriterRank = 0; WriterRank < WriterCount; WriterRank++)
     {
         // variable metadata for timestep
-        size_t ThisMDSize = helper::ReadValue<uint64_t>(
-            m_Metadata.m_Buffer, Position, m_Minifooter.IsLittleEndian);
-        char *ThisMD = m_Metadata.m_Buffer.data() + MDPosition;
-        if (m_OpenMode == Mode::ReadRandomAccess)
+        const size_t BlockSize = ReadMetadataValue(Buffer, Position);
+        size_t ThisMDSize = BlockSize;
+        char *ThisMD = Buffer + MDPosition;
+        if (m_MetadataDeltas)
+        {
+            const uint64_t BlockPos =
+                m_MetadataIndexTable[Step][4] + MDPosition - pgstart;
+            ThisMD = ExpandMetadataBlock(Step, WriterRank, ThisMD, ThisMDSize,
+                                         BlockPos);
+        }
+        if (Reinstall)
+        {
+            m_BP5Deserializer->ReinstallMetaData(ThisMD, ThisMDSize,
+                                                 WriterRank, Step);
+        }
+        else if (m_OpenMode == Mode::ReadRandomAccess)
         {
             m_BP5Deserializer->InstallMetaData(ThisMD, ThisMDSize, WriterRank,
                                                Step);
@@ -58,23 +93,222 @@ void BP5Reader::InstallMetadataForTimestep(size_t Step)
         {
             m_BP5Deserializer->InstallMetaData(ThisMD, ThisMDSize, WriterRank);
         }
-        MDPosition += ThisMDSize;
+        MDPosition += BlockSize;
+    }
+    if (Reinstall)
+    {
+        // attributes were installed when the step was first seen
+        return;
     }
     for (size_t WriterRank = 0; WriterRank < WriterCount; WriterRank++)
     {
         // attribute metadata for timestep
-        size_t ThisADSize = helper::ReadValue<uint64_t>(
-            m_Metadata.m_Buffer, Position, m_Minifooter.IsLittleEndian);
-        char *ThisAD = m_Metadata.m_Buffer.data() + MDPosition;
+        size_t ThisADSize = ReadMetadataValue(Buffer, Position);
+        char *ThisAD = Buffer + MDPosition;
         if (ThisADSize > 0)
             m_BP5Deserializer->InstallAttributeData(ThisAD, ThisADSize);
         MDPosition += ThisADSize;
     }
 }
 
+uint64_t BP5Reader::ReadMetadataValue(const char *Buffer,
+                                      size_t &Position) const
+{
+    uint64_t value;
+    std::memcpy(&value, Buffer + Position, sizeof(value));
+    if (helper::IsLittleEndian() != m_Minifooter.IsLittleEndian)
+    {
+        char *bytes = reinterpret_cast<char *>(&value);
+        std::reverse(bytes, bytes + sizeof(value));
+    }
+    Position += sizeof(value);
+    return value;
+}
+
+void BP5Reader::OpenMetadataFile()
+{
+    if (m_MDFileManager.m_Transports.empty())
+    {
+        // only rank 0 opens md.0 in Open
+        m_MDFileManager.OpenFiles({GetBPMetadataFileName(m_Name)}, Mode::Read,
+                                  m_IO.m_TransportsParameters, false);
+    }
+}
+
+char *BP5Reader::ExpandMetadataBlock(size_t Step, size_t WriterRank,
+                                     char *Block, size_t &BlockSize,
+                                     uint64_t BlockPos)
+{
+    size_t Position = 0;
+    const uint64_t Kind = ReadMetadataValue(Block, Position);
+    if (Kind == format::BP5Base::MetadataKeyframe)
+    {
+        // keep a copy, the block itself may get decoded in place
+        auto &Keyframe = m_MetadataKeyframes[WriterRank];
+        Keyframe.first = BlockPos + Position;
+        Keyframe.second.assign(Block + Position, Block + BlockSize);
+        BlockSize -= Position;
+        return Block + Position;
+    }
+    const uint64_t KeyframePos = ReadMetadataValue(Block, Position);
+    const size_t FullSize = ReadMetadataValue(Block, Position);
+    const uint64_t RunCount = ReadMetadataValue(Block, Position);
+
+    auto &Keyframe = m_MetadataKeyframes[WriterRank];
+    if (Keyframe.first != KeyframePos || Keyframe.second.size() < FullSize)
+    {
+        // not seen, e.g. the keyframe step was not selected or was evicted
+        OpenMetadataFile();
+        Keyframe.first = KeyframePos;
+        Keyframe.second.resize(FullSize);
+        m_MDFileManager.ReadFile(Keyframe.second.data(), FullSize,
+                                 KeyframePos);
+    }
+
+    m_ExpandedMetadata[Step].emplace_back(Keyframe.second.begin(),
+                                          Keyframe.second.begin() + FullSize);
+    char *Full = m_ExpandedMetadata[Step].back().data();
+    size_t FullPos = 0;
+    for (uint64_t i = 0; i < RunCount; ++i)
+    {
+        FullPos += ReadMetadataValue(Block, Position);
+        const size_t Length = ReadMetadataValue(Block, Position);
+        if (FullPos + Length > FullSize || Position + Length > BlockSize)
+        {
+            helper::Throw<std::runtime_error>(
+                "Engine", "BP5Reader", "ExpandMetadataBlock",
+                "corrupt delta encoded metadata of writer " +
+                    std::to_string(WriterRank) + " in step " +
+                    std::to_string(Step));
+        }
+        std::memcpy(Full + FullPos, Block + Position, Length);
+        FullPos += Length;
+        Position += (Length + 7) & ~static_cast<size_t>(0x7);
+    }
+    BlockSize = FullSize;
+    return Full;
+}
+
+void BP5Reader::LoadStepMetadata(size_t Step)
+{
+    if (m_SharedMetadata)
+    {
+        InstallMetadataForTimestep(Step, m_SharedMetadata,
+                                   m_MetadataIndexTable[Step][0], true);
+        return;
+    }
+    OpenMetadataFile();
+    std::vector<char> &buffer = m_StepMetadata[Step];
+    buffer.resize(m_MetadataIndexTable[Step][1]);
+    m_MDFileManager.ReadFile(buffer.data(), buffer.size(),
+                             m_MetadataIndexTable[Step][4]);
+    InstallMetadataForTimestep(Step, buffer.data(), 0, true);
+}
+
+void BP5Reader::InstallMetadataInBatches()
+{
+    // index variables and attributes of all steps while keeping only the
+    // most recently used steps installed, rank 0 reads as many steps as the
+    // cache holds and broadcasts them at once
+    const size_t nSteps = m_MetadataIndexTable.size();
+    const size_t batchSteps = m_Parameters.MetadataCacheSteps;
+    std::vector<char> batch;
+    for (size_t First = 0; First < nSteps; First += batchSteps)
+    {
+        const size_t Last = std::min(First + batchSteps, nSteps);
+        if (m_Comm.Rank() == 0)
+        {
+            size_t batchSize = 0;
+            for (size_t Step = First; Step < Last; ++Step)
+            {
+                batchSize += m_MetadataIndexTable[Step][1];
+            }
+            batch.resize(batchSize);
+            size_t pos = 0;
+            for (size_t Step = First; Step < Last; ++Step)
+            {
+                const size_t size = m_MetadataIndexTable[Step][1];
+                m_MDFileManager.ReadFile(batch.data() + pos, size,
+                                         m_MetadataIndexTable[Step][4]);
+                pos += size;
+            }
+        }
+        m_Comm.BroadcastVector(batch);
+
+        size_t pos = 0;
+        for (size_t Step = First; Step < Last; ++Step)
+        {
+            const size_t size = m_MetadataIndexTable[Step][1];
+            m_BP5Deserializer->SetupForStep(
+                Step, m_WriterMap[m_WriterMapIndex[Step]].WriterCount);
+            std::vector<char> &buffer = m_StepMetadata[Step];
+            buffer.assign(batch.begin() + pos, batch.begin() + pos + size);
+            pos += size;
+            InstallMetadataForTimestep(Step, buffer.data(), 0);
+            TrimMetadataCache();
+        }
+    }
+}
+
+void BP5Reader::TrimMetadataCache()
+{
+    if (!m_LazyMetadata)
+    {
+        return;
+    }
+    const std::vector<size_t> steps = m_BP5Deserializer->InstalledStepsByUse();
+    const size_t capacity = m_Parameters.MetadataCacheSteps;
+    for (size_t i = 0; i + capacity < steps.size(); ++i)
+    {
+        m_BP5Deserializer->EvictStep(steps[i]);
+        m_StepMetadata.erase(steps[i]);
+        m_ExpandedMetadata.erase(steps[i]);
+    }
+}
+
+void BP5Reader::ShareMetadataOnNode()
+{
+    m_NodeComm = m_Comm.GroupByShm("creating node communicator in BP5Reader");
+    const bool isNodeLeader = (m_NodeComm.Rank() == 0);
+    // rank 0 is the leader of its node and rank 0 of the leaders
+    helper::Comm leaderComm =
+        m_Comm.Split(isNodeLeader ? 0 : 1, m_Comm.Rank(),
+                     "creating node leaders communicator in BP5Reader");
+    if (isNodeLeader)
+    {
+        leaderComm.BroadcastVector(m_Metadata.m_Buffer);
+        const size_t size = m_Metadata.m_Buffer.size();
+        m_SharedMetadataWin = m_NodeComm.Win_allocate_shared(
+            size, 1, &m_SharedMetadata, "allocating shared metadata");
+        std::memcpy(m_SharedMetadata, m_Metadata.m_Buffer.data(), size);
+    }
+    else
+    {
+        m_SharedMetadataWin = m_NodeComm.Win_allocate_shared(
+            0, 1, &m_SharedMetadata, "allocating shared metadata");
+        size_t size;
+        int disp_unit;
+        m_NodeComm.Win_shared_query(m_SharedMetadataWin, 0, &size, &disp_unit,
+                                    &m_SharedMetadata,
+                                    "querying shared metadata");
+    }
+    m_NodeComm.Barrier("waiting for shared metadata");
+    std::vector<char>().swap(m_Metadata.m_Buffer);
+}
+
+void BP5Reader::FreeSharedMetadata()
+{
+    if (m_SharedMetadata)
+    {
+        m_NodeComm.Win_free(m_SharedMetadataWin, "freeing shared metadata");
+        m_SharedMetadata = nullptr;
+    }
+}
+
 StepStatus BP5Reader::BeginStep(StepMode mode, const float timeoutSeconds)
 {
     PERFSTUBS_SCOPED_TIMER("BP5Reader::BeginStep");
+    WaitForAsyncGets();
 
     if (m_OpenMode == Mode::ReadRandomAccess)
     {
@@ -173,14 +407,14 @@ void BP5Reader::EndStep()
     m_BetweenStepPairs = false;
     PERFSTUBS_SCOPED_TIMER("BP5Reader::EndStep");
     PerformGets();
+    if (m_Parameters.PrefetchSteps > 0)
+    {
+        LaunchPrefetch();
+    }
 }
 
-void BP5Reader::ReadData(const size_t WriterRank, const size_t Timestep,
-                         const size_t StartOffset, const size_t Length,
-                         char *Destination)
+size_t BP5Reader::OpenDataFile(const size_t WriterRank, const size_t Timestep)
 {
-    size_t FlushCount = m_MetadataIndexTable[Timestep][2];
-    size_t DataPosPos = m_MetadataIndexTable[Timestep][3];
     size_t SubfileNum = static_cast<size_t>(
         m_WriterMap[m_WriterMapIndex[Timestep]].RankToSubfile[WriterRank]);
 
@@ -193,6 +427,38 @@ void BP5Reader::ReadData(const size_t WriterRank, const size_t Timestep,
         m_DataFileManager.OpenFileID(subFileName, SubfileNum, Mode::Read,
                                      {{"transport", "File"}}, false);
     }
+    return SubfileNum;
+}
+
+size_t BP5Reader::ReadableDataSize(const size_t WriterRank,
+                                   const size_t Timestep)
+{
+    const size_t SubfileNum = OpenDataFile(WriterRank, Timestep);
+    size_t FlushCount = m_MetadataIndexTable[Timestep][2];
+    size_t DataPosPos = m_MetadataIndexTable[Timestep][3];
+    size_t Position =
+        DataPosPos + (WriterRank * (2 * FlushCount + 1) * sizeof(uint64_t));
+    size_t Size = 0;
+    for (size_t flush = 0; flush < FlushCount; flush++)
+    {
+        Position += sizeof(uint64_t);
+        Size += helper::ReadValue<uint64_t>(m_MetadataIndex.m_Buffer, Position,
+                                            m_Minifooter.IsLittleEndian);
+    }
+    // the size of the last part is only known from the metadata
+    const size_t LastPos = helper::ReadValue<uint64_t>(
+        m_MetadataIndex.m_Buffer, Position, m_Minifooter.IsLittleEndian);
+    const size_t FileSize = m_DataFileManager.GetFileSize(SubfileNum);
+    return Size + (FileSize > LastPos ? FileSize - LastPos : 0);
+}
+
+void BP5Reader::ReadData(const size_t WriterRank, const size_t Timestep,
+                         const size_t StartOffset, const size_t Length,
+                         char *Destination)
+{
+    size_t FlushCount = m_MetadataIndexTable[Timestep][2];
+    size_t DataPosPos = m_MetadataIndexTable[Timestep][3];
+    size_t SubfileNum = OpenDataFile(WriterRank, Timestep);
 
     size_t InfoStartPos =
         DataPosPos + (WriterRank * (2 * FlushCount + 1) * sizeof(uint64_t));
@@ -225,18 +491,300 @@ void BP5Reader::ReadData(const size_t WriterRank, const size_t Timestep,
                                SubfileNum);
 }
 
+void BP5Reader::ReadCoalesced(
+    const std::vector<format::BP5Deserializer::ReadRequest> &Requests)
+{
+    // a gap up to this size is read rather than split into two reads
+    constexpr size_t MaxGap = 4096;
+    // requests at least this large are always read on their own
+    constexpr size_t MaxMergedRequest = 1024 * 1024;
+
+    std::vector<size_t> Order(Requests.size());
+    for (size_t i = 0; i < Order.size(); ++i)
+    {
+        Order[i] = i;
+    }
+    std::sort(Order.begin(), Order.end(), [&](const size_t a, const size_t b) {
+        const auto &A = Requests[a];
+        const auto &B = Requests[b];
+        if (A.WriterRank != B.WriterRank)
+            return A.WriterRank < B.WriterRank;
+        if (A.Timestep != B.Timestep)
+            return A.Timestep < B.Timestep;
+        return A.StartOffset < B.StartOffset;
+    });
+
+    std::vector<char> Staging;
+    size_t First = 0;
+    while (First < Order.size())
+    {
+        const auto &Head = Requests[Order[First]];
+        size_t End = Head.StartOffset + Head.ReadLength;
+        size_t Last = First + 1;
+        if (Head.ReadLength < MaxMergedRequest)
+        {
+            for (; Last < Order.size(); ++Last)
+            {
+                const auto &Next = Requests[Order[Last]];
+                if (Next.WriterRank != Head.WriterRank ||
+                    Next.Timestep != Head.Timestep ||
+                    Next.ReadLength >= MaxMergedRequest ||
+                    Next.StartOffset > End + MaxGap)
+                {
+                    break;
+                }
+                End = std::max(End, Next.StartOffset + Next.ReadLength);
+            }
+        }
+
+        if (Last == First + 1)
+        {
+            ReadData(Head.WriterRank, Head.Timestep, Head.StartOffset,
+                     Head.ReadLength, Head.DestinationAddr);
+        }
+        else
+        {
+            Staging.resize(End - Head.StartOffset);
+            ReadData(Head.WriterRank, Head.Timestep, Head.StartOffset,
+                     Staging.size(), Staging.data());
+            for (size_t i = First; i < Last; ++i)
+            {
+                const auto &Req = Requests[Order[i]];
+                const size_t Pos = Req.StartOffset - Head.StartOffset;
+                std::memcpy(Req.DestinationAddr, Staging.data() + Pos,
+                            Req.ReadLength);
+            }
+        }
+        First = Last;
+    }
+}
+
+void BP5Reader::AddToPrefetchPattern(
+    const std::vector<format::BP5Deserializer::ReadRequest> &Requests)
+{
+    if (m_PrefetchPatternStep != m_CurrentStep)
+    {
+        // the pattern follows the most recent step only
+        m_PrefetchPattern.clear();
+        m_PrefetchPatternStep = m_CurrentStep;
+    }
+    for (const auto &Req : Requests)
+    {
+        m_PrefetchPattern.push_back(
+            {Req.WriterRank, Req.StartOffset, Req.ReadLength, {}});
+    }
+    std::sort(m_PrefetchPattern.begin(), m_PrefetchPattern.end(),
+              [](const PrefetchRange &a, const PrefetchRange &b) {
+                  if (a.WriterRank != b.WriterRank)
+                      return a.WriterRank < b.WriterRank;
+                  return a.StartOffset < b.StartOffset;
+              });
+    // merge overlapping and adjacent ranges of the same writer
+    size_t Last = 0;
+    for (size_t i = 1; i < m_PrefetchPattern.size(); ++i)
+    {
+        auto &Prev = m_PrefetchPattern[Last];
+        const auto &Range = m_PrefetchPattern[i];
+        if (Range.WriterRank == Prev.WriterRank &&
+            Range.StartOffset <= Prev.StartOffset + Prev.Length)
+        {
+            Prev.Length = std::max(Prev.Length, Range.StartOffset +
+                                                    Range.Length -
+                                                    Prev.StartOffset);
+        }
+        else
+        {
+            m_PrefetchPattern[++Last] = Range;
+        }
+    }
+    if (!m_PrefetchPattern.empty())
+    {
+        m_PrefetchPattern.resize(Last + 1);
+    }
+}
+
+std::vector<format::BP5Deserializer::ReadRequest>
+BP5Reader::ReadFromPrefetched(
+    const std::vector<format::BP5Deserializer::ReadRequest> &Requests)
+{
+    WaitForPrefetch();
+    // steps already passed are not requested anymore
+    m_Prefetched.erase(m_Prefetched.begin(),
+                       m_Prefetched.lower_bound(m_CurrentStep));
+
+    std::vector<format::BP5Deserializer::ReadRequest> Misses;
+    for (const auto &Req : Requests)
+    {
+        const PrefetchRange *Hit = nullptr;
+        auto it = m_Prefetched.find(Req.Timestep);
+        if (it != m_Prefetched.end())
+        {
+            for (const auto &Range : it->second)
+            {
+                if (Range.WriterRank == Req.WriterRank &&
+                    Range.StartOffset <= Req.StartOffset &&
+                    Req.StartOffset + Req.ReadLength <=
+                        Range.StartOffset + Range.Length)
+                {
+                    Hit = &Range;
+                    break;
+                }
+            }
+        }
+        if (Hit)
+        {
+            std::memcpy(Req.DestinationAddr,
+                        Hit->Data.data() + Req.StartOffset - Hit->StartOffset,
+                        Req.ReadLength);
+        }
+        else
+        {
+            Misses.push_back(Req);
+        }
+    }
+    AddToPrefetchPattern(Requests);
+    return Misses;
+}
+
+void BP5Reader::LaunchPrefetch()
+{
+    WaitForPrefetch();
+    m_Prefetched.erase(m_Prefetched.begin(),
+                       m_Prefetched.upper_bound(m_CurrentStep));
+    if (m_PrefetchPattern.empty() || m_PrefetchPatternStep != m_CurrentStep)
+    {
+        // nothing was read in this step
+        return;
+    }
+
+    const size_t End = std::min<size_t>(
+        m_CurrentStep + 1 + m_Parameters.PrefetchSteps, m_StepsCount);
+    std::vector<size_t> Steps;
+    auto Requests =
+        std::make_shared<std::vector<format::BP5Deserializer::ReadRequest>>();
+    for (size_t Step = std::max(m_PrefetchedUpTo, m_CurrentStep + 1);
+         Step < End; ++Step)
+    {
+        // the buffers are allocated here, the thread only fills them
+        auto &Ranges = m_Prefetched[Step];
+        size_t Readable = 0;
+        for (size_t i = 0; i < m_PrefetchPattern.size(); ++i)
+        {
+            PrefetchRange Range = m_PrefetchPattern[i];
+            if (i == 0 ||
+                Range.WriterRank != m_PrefetchPattern[i - 1].WriterRank)
+            {
+                Readable = ReadableDataSize(Range.WriterRank, Step);
+            }
+            // the layout of the step is not known yet, so a range may
+            // reach beyond the end of the file
+            if (Range.StartOffset >= Readable)
+            {
+                continue;
+            }
+            Range.Length =
+                std::min(Range.Length, Readable - Range.StartOffset);
+            Range.Data.resize(Range.Length);
+            Ranges.push_back(std::move(Range));
+        }
+        for (auto &Range : Ranges)
+        {
+            Requests->push_back({Step, Range.WriterRank, Range.StartOffset,
+                                 Range.Length, Range.Data.data(), nullptr});
+        }
+        Steps.push_back(Step);
+    }
+    if (Steps.empty())
+    {
+        return;
+    }
+    m_PrefetchedUpTo = End;
+
+    m_Prefetch = std::async(std::launch::async, [this, Requests, Steps]() {
+        std::vector<size_t> Failed;
+        auto First = Requests->begin();
+        for (const size_t Step : Steps)
+        {
+            auto Last = std::find_if(
+                First, Requests->end(),
+                [Step](const format::BP5Deserializer::ReadRequest &Req) {
+                    return Req.Timestep != Step;
+                });
+            try
+            {
+                ReadCoalesced(
+                    std::vector<format::BP5Deserializer::ReadRequest>(First,
+                                                                      Last));
+            }
+            catch (std::exception &)
+            {
+                // the Gets of this step will read from the file instead
+                Failed.push_back(Step);
+            }
+            First = Last;
+        }
+        return Failed;
+    });
+}
+
+void BP5Reader::WaitForPrefetch()
+{
+    if (m_Prefetch.valid())
+    {
+        for (const size_t Step : m_Prefetch.get())
+        {
+            m_Prefetched.erase(Step);
+        }
+    }
+}
+
 void BP5Reader::PerformGets()
 {
     PERFSTUBS_SCOPED_TIMER("BP5Reader::PerformGets");
+    WaitForAsyncGets();
     auto ReadRequests = m_BP5Deserializer->GenerateReadRequests();
-    // Potentially optimize read requests, make contiguous, etc.
-    for (const auto &Req : ReadRequests)
+    if (m_Parameters.PrefetchSteps > 0 && m_OpenMode == Mode::Read)
+    {
+        ReadCoalesced(ReadFromPrefetched(ReadRequests));
+    }
+    else
     {
-        ReadData(Req.WriterRank, Req.Timestep, Req.StartOffset, Req.ReadLength,
-                 Req.DestinationAddr);
+        ReadCoalesced(ReadRequests);
     }
 
     m_BP5Deserializer->FinalizeGets(ReadRequests);
+
+    // no request refers to the metadata anymore
+    TrimMetadataCache();
+}
+
+std::future<void> BP5Reader::PerformGetsAsync()
+{
+    PERFSTUBS_SCOPED_TIMER("BP5Reader::PerformGetsAsync");
+    WaitForAsyncGets();
+    auto ReadRequests =
+        std::make_shared<std::vector<format::BP5Deserializer::ReadRequest>>(
+            m_BP5Deserializer->GenerateReadRequests());
+    auto Misses = std::make_shared<
+        std::vector<format::BP5Deserializer::ReadRequest>>();
+    if (m_Parameters.PrefetchSteps > 0 && m_OpenMode == Mode::Read)
+    {
+        *Misses = ReadFromPrefetched(*ReadRequests);
+    }
+    else
+    {
+        *Misses = *ReadRequests;
+    }
+    return LaunchAsyncGets([this, ReadRequests, Misses]() {
+        ReadCoalesced(*Misses);
+        m_BP5Deserializer->FinalizeGets(*ReadRequests);
+    });
+}
+
+void BP5Reader::AsyncGetsDone()
+{
+    // the main thread may be using the metadata, so it trims the cache
+    TrimMetadataCache();
 }
 
 // PRIVATE
@@ -255,6 +803,17 @@ void BP5Reader::Init()
     m_IO.m_ReadStreaming = false;
 
     ParseParams(m_IO, m_Parameters);
+    m_NodeSharedMetadata = (m_OpenMode == Mode::ReadRandomAccess) &&
+                           m_Parameters.NodeSharedMetadata &&
+                           (m_Comm.Size() > 1);
+    if (m_NodeSharedMetadata && m_Parameters.MetadataCacheSteps == 0)
+    {
+        // shared metadata cannot be decoded in place, without a cache every
+        // rank would hold a private decoded copy of all steps
+        m_Parameters.MetadataCacheSteps = 1;
+    }
+    m_LazyMetadata = (m_OpenMode == Mode::ReadRandomAccess) &&
+                     (m_Parameters.MetadataCacheSteps > 0);
     m_ReaderIsRowMajor = (m_IO.m_ArrayOrder == ArrayOrdering::RowMajor);
     InitTransports();
     if (!m_Parameters.SelectSteps.empty())
@@ -571,7 +1130,13 @@ void BP5Reader::InitBuffer(const TimePoint &timeoutInstant,
                 }
             } while (SleepOrQuit(timeoutInstant, pollSeconds));
 
-            if (actualFileSize >= expectedMinFileSize)
+            if ((actualFileSize >= expectedMinFileSize) && m_LazyMetadata &&
+                !m_NodeSharedMetadata)
+            {
+                // metadata is read step by step below
+                m_MDFileAlreadyReadSize = expectedMinFileSize;
+            }
+            else if (actualFileSize >= expectedMinFileSize)
             {
                 m_Metadata.Resize(fileFilteredSize,
                                   "allocating metadata buffer, "
@@ -608,8 +1173,15 @@ void BP5Reader::InitBuffer(const TimePoint &timeoutInstant,
             }
         }
 
-        // broadcast buffer to all ranks from zero
-        m_Comm.BroadcastVector(m_Metadata.m_Buffer);
+        if (m_NodeSharedMetadata)
+        {
+            ShareMetadataOnNode();
+        }
+        else
+        {
+            // broadcast buffer to all ranks from zero
+            m_Comm.BroadcastVector(m_Metadata.m_Buffer);
+        }
 
         // broadcast metadata index buffer to all ranks from zero
         m_Comm.BroadcastVector(m_MetaMetadata.m_Buffer);
@@ -618,16 +1190,33 @@ void BP5Reader::InitBuffer(const TimePoint &timeoutInstant,
             new format::BP5Deserializer(m_WriterIsRowMajor, m_ReaderIsRowMajor,
                                         (m_OpenMode == Mode::ReadRandomAccess));
         m_BP5Deserializer->m_Engine = this;
+        m_BP5Deserializer->m_MetadataIsShared = (m_SharedMetadata != nullptr);
+        m_BP5Deserializer->m_DecompressedCacheSize =
+            m_Parameters.DecompressedCacheSize;
 
         InstallMetaMetaData(m_MetaMetadata);
 
         if (m_OpenMode == Mode::ReadRandomAccess)
         {
-            for (size_t Step = 0; Step < m_MetadataIndexTable.size(); Step++)
+            if (m_LazyMetadata)
+            {
+                m_BP5Deserializer->SetStepInstaller(
+                    [this](size_t Step) { LoadStepMetadata(Step); });
+            }
+            if (!m_LazyMetadata || m_SharedMetadata)
+            {
+                for (size_t Step = 0; Step < m_MetadataIndexTable.size();
+                     Step++)
+                {
+                    m_BP5Deserializer->SetupForStep(
+                        Step, m_WriterMap[m_WriterMapIndex[Step]].WriterCount);
+                    InstallMetadataForTimestep(Step);
+                    TrimMetadataCache();
+                }
+            }
+            else
             {
-                m_BP5Deserializer->SetupForStep(
-                    Step, m_WriterMap[m_WriterMapIndex[Step]].WriterCount);
-                InstallMetadataForTimestep(Step);
+                InstallMetadataInBatches();
             }
         }
         // fills IO with Variables and Attributes
@@ -692,8 +1281,19 @@ void BP5Reader::ParseMetadataIndex(format::BufferSTL &bufferSTL,
                     std::to_string(m_Minifooter.Version) + " version");
         }
 
-        // BP minor version, unused
+        // BP minor version
         position = m_BPMinorVersionPosition;
+        const uint8_t minorVersion = helper::ReadValue<uint8_t>(
+            buffer, position, m_Minifooter.IsLittleEndian);
+        if (minorVersion > m_BPMinorVersionMax)
+        {
+            helper::Throw<std::runtime_error>(
+                "Engine", "BP5Reader", "ParseMetadataIndex",
+                "ADIOS2 BP5 Engine supports bp format minor versions up to " +
+                    std::to_string(m_BPMinorVersionMax) + ", found " +
+                    std::to_string(minorVersion) +
+                    ", the file was written by a newer version of ADIOS2");
+        }
 
         // Writer active flag
         position = m_ActiveFlagPosition;
@@ -705,6 +1305,11 @@ void BP5Reader::ParseMetadataIndex(format::BufferSTL &bufferSTL,
         const uint8_t val = helper::ReadValue<uint8_t>(
             buffer, position, m_Minifooter.IsLittleEndian);
         m_WriterIsRowMajor = val == 'n';
+
+        position = m_MetadataDeltaFlagPosition;
+        m_MetadataDeltas = (helper::ReadValue<uint8_t>(
+                                buffer, position,
+                                m_Minifooter.IsLittleEndian) == 'y');
         // move position to first row
         position = m_IndexHeaderSize;
     }
@@ -798,7 +1403,8 @@ void BP5Reader::ParseMetadataIndex(format::BufferSTL &bufferSTL,
                 m_FilteredMetadataInfo.push_back(
                     std::make_pair(minfo_pos, minfo_size));
             }
-            minfo_pos = MetadataPos;
+            // the next selected range starts after this step
+            minfo_pos = MetadataPos + MetadataSize;
             minfo_size = 0;
         }
 
@@ -836,8 +1442,11 @@ ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 void BP5Reader::DoClose(const int transportIndex)
 {
     PERFSTUBS_SCOPED_TIMER("BP5Reader::Close");
+    WaitForAsyncGets();
+    WaitForPrefetch();
     m_DataFileManager.CloseFiles();
     m_MDFileManager.CloseFiles();
+    FreeSharedMetadata();
 }
 
 // DoBlocksInfo will not be called because MinBlocksInfo is operative
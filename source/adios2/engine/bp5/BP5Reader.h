@@ -21,7 +21,9 @@
 #include "adios2/toolkit/transportman/TransportMan.h"
 
 #include <chrono>
+#include <future>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace adios2
@@ -56,6 +58,10 @@ public:
 
     void PerformGets() final;
 
+    /** requests are generated on the calling thread, the data is read and
+     * placed on a background thread */
+    std::future<void> PerformGetsAsync() final;
+
     MinVarInfo *MinBlocksInfo(const VariableBase &, const size_t Step) const;
     Dims *VarShape(const VariableBase &, const size_t Step) const;
     bool VariableMinMax(const VariableBase &, const size_t Step,
@@ -214,10 +220,88 @@ private:
                                          bool hasHeader);
     void InstallMetaMetaData(format::BufferSTL MetaMetadata);
     void InstallMetadataForTimestep(size_t Step);
+    void InstallMetadataForTimestep(size_t Step, char *Buffer, size_t pgstart,
+                                    bool Reinstall = false);
+    uint64_t ReadMetadataValue(const char *Buffer, size_t &Position) const;
+    void OpenMetadataFile();
+
+    /* Written with MetadataKeyframeInterval: the metadata block of a writer
+     * is a keyframe or the difference to the last keyframe of the writer */
+    bool m_MetadataDeltas = false;
+    // writer rank -> position in md.0 and content of its last keyframe
+    std::unordered_map<size_t, std::pair<uint64_t, std::vector<char>>>
+        m_MetadataKeyframes;
+    // step -> expanded metadata blocks, referenced by the deserializer
+    std::unordered_map<size_t, std::vector<std::vector<char>>>
+        m_ExpandedMetadata;
+    char *ExpandMetadataBlock(size_t Step, size_t WriterRank, char *Block,
+                              size_t &BlockSize, uint64_t BlockPos);
+
+    /* ReadRandomAccess with MetadataCacheSteps > 0: only the metadata of
+     * the most recently used steps stays installed.  m_Metadata is not
+     * kept.  Open broadcasts the steps from rank 0 in batches of
+     * MetadataCacheSteps.  An evicted step is read from md.0 again by the
+     * rank that needs it: Gets and metadata queries are not collective, so
+     * the reload cannot wait for a broadcast from rank 0. */
+    bool m_LazyMetadata = false;
+    std::unordered_map<size_t, std::vector<char>> m_StepMetadata;
+    void InstallMetadataInBatches();
+    void LoadStepMetadata(size_t Step);
+    void TrimMetadataCache();
+
+    void AsyncGetsDone() final;
+
+    /* ReadRandomAccess with NodeSharedMetadata: one rank per node receives
+     * the metadata into a shared memory window that the other ranks of the
+     * node map read-only instead of holding their own copy.  It implies
+     * MetadataCacheSteps=1 unless a larger cache is given. */
+    helper::Comm m_NodeComm;
+    helper::Comm::Win m_SharedMetadataWin;
+    bool m_NodeSharedMetadata = false;
+    char *m_SharedMetadata = nullptr;
+    void ShareMetadataOnNode();
+    void FreeSharedMetadata();
+    size_t OpenDataFile(const size_t WriterRank, const size_t Timestep);
     void ReadData(const size_t WriterRank, const size_t Timestep,
                   const size_t StartOffset, const size_t Length,
                   char *Destination);
 
+    /* Reads the requests ordered by writer, step and offset.  Requests of
+     * the same writer and step that overlap or lie close together are read
+     * with a single ReadData into a staging buffer. */
+    void ReadCoalesced(
+        const std::vector<format::BP5Deserializer::ReadRequest> &Requests);
+
+    /* Mode::Read with PrefetchSteps > 0: the data ranges read in one step
+     * are read for the next PrefetchSteps steps on a background thread
+     * after EndStep.  Requests of a later step that lie within a range of
+     * that step are copied from memory, all others are read as usual.
+     * Only bytes of the file are kept, so a range that does not match
+     * the layout of a later step is never wrong, only unused. */
+    struct PrefetchRange
+    {
+        size_t WriterRank;
+        size_t StartOffset;
+        size_t Length;
+        std::vector<char> Data;
+    };
+    // ranges read in m_PrefetchPatternStep, merged per writer
+    std::vector<PrefetchRange> m_PrefetchPattern;
+    size_t m_PrefetchPatternStep = 0;
+    // step -> ranges read ahead for that step
+    std::map<size_t, std::vector<PrefetchRange>> m_Prefetched;
+    // steps below this one have been read ahead already
+    size_t m_PrefetchedUpTo = 0;
+    // resolves to the steps whose prefetch failed
+    std::future<std::vector<size_t>> m_Prefetch;
+    void AddToPrefetchPattern(
+        const std::vector<format::BP5Deserializer::ReadRequest> &Requests);
+    std::vector<format::BP5Deserializer::ReadRequest> ReadFromPrefetched(
+        const std::vector<format::BP5Deserializer::ReadRequest> &Requests);
+    size_t ReadableDataSize(const size_t WriterRank, const size_t Timestep);
+    void LaunchPrefetch();
+    void WaitForPrefetch();
+
     struct WriterMapStruct
     {
         uint32_t WriterCount = 0;
@@ -18,8 +18,10 @@
 #include "adios2/toolkit/transport/file/FileFStream.h"
 #include <adios2-perfstubs-interface.h>
 
+#include <cstring>
 #include <ctime>
 #include <iostream>
+#include <numeric>
 
 namespace adios2
 {
@@ -99,13 +101,14 @@ StepStatus BP5Writer::BeginStep(StepMode mode, const float timeoutSeconds)
         m_BP5Serializer.InitStep(new MallocV(
             "BP5Writer", false, m_BP5Serializer.m_BufferAlign,
             m_BP5Serializer.m_BufferBlockSize, m_Parameters.InitialBufferSize,
-            m_Parameters.GrowthFactor));
+            m_Parameters.GrowthFactor, m_Parameters.Threads));
     }
     else
     {
         m_BP5Serializer.InitStep(new ChunkV(
             "BP5Writer", false, m_BP5Serializer.m_BufferAlign,
-            m_BP5Serializer.m_BufferBlockSize, m_Parameters.BufferChunkSize));
+            m_BP5Serializer.m_BufferBlockSize, m_Parameters.BufferChunkSize,
+            m_Parameters.Threads));
     }
     m_ThisTimestepDataSize = 0;
 
@@ -190,6 +193,39 @@ BP5Writer::WriteMetadata(const std::vector<core::iovec> &MetaDataBlocks,
     return MetaDataSize;
 }
 
+void BP5Writer::ResolveMetadataKeyframes(
+    const std::vector<core::iovec> &MetaDataBlocks,
+    std::vector<char> &Aggregate)
+{
+    // WriteMetadata puts the total size and two sizes per writer first
+    uint64_t pos = m_MetaDataPos + sizeof(uint64_t) +
+                   2 * sizeof(uint64_t) * MetaDataBlocks.size();
+    m_MetadataKeyframePos.resize(MetaDataBlocks.size(), 0);
+    for (size_t WriterRank = 0; WriterRank < MetaDataBlocks.size();
+         ++WriterRank)
+    {
+        // the blocks point into the gathered metadata, which this rank owns
+        char *block = Aggregate.data() +
+                      (static_cast<const char *>(
+                           MetaDataBlocks[WriterRank].iov_base) -
+                       Aggregate.data());
+        uint64_t kind;
+        std::memcpy(&kind, block, sizeof(kind));
+        if (kind == format::BP5Base::MetadataKeyframe)
+        {
+            m_MetadataKeyframePos[WriterRank] = pos + sizeof(kind);
+        }
+        else
+        {
+            format::BP5Base::MetadataDeltaHeader header;
+            std::memcpy(&header, block, sizeof(header));
+            header.KeyframePos = m_MetadataKeyframePos[WriterRank];
+            std::memcpy(block, &header, sizeof(header));
+        }
+        pos += MetaDataBlocks[WriterRank].iov_len;
+    }
+}
+
 void BP5Writer::AsyncWriteDataCleanup()
 {
     if (m_Parameters.AsyncWrite)
@@ -494,22 +530,32 @@ void BP5Writer::EndStep()
         TSInfo.NewMetaMetaBlocks, TSInfo.MetaEncodeBuffer,
         TSInfo.AttributeEncodeBuffer, m_ThisTimestepDataSize, m_StartDataPos);
 
-    size_t LocalSize = MetaBuffer.size();
-    std::vector<size_t> RecvCounts = m_Comm.GatherValues(LocalSize, 0);
-
+    std::vector<size_t> RecvCounts;
     std::vector<char> *RecvBuffer = new std::vector<char>;
-    if (m_Comm.Rank() == 0)
+    if (m_TwoLevelMetadata)
     {
-        uint64_t TotalSize = 0;
-        for (auto &n : RecvCounts)
-            TotalSize += n;
-        RecvBuffer->resize(TotalSize);
+        m_Profiler.Start("meta_gather");
+        GatherMetadataTwoLevel(MetaBuffer, RecvCounts, *RecvBuffer);
+        m_Profiler.Stop("meta_gather");
     }
+    else
+    {
+        size_t LocalSize = MetaBuffer.size();
+        RecvCounts = m_Comm.GatherValues(LocalSize, 0);
 
-    m_Profiler.Start("meta_gather");
-    m_Comm.GathervArrays(MetaBuffer.data(), LocalSize, RecvCounts.data(),
-                         RecvCounts.size(), RecvBuffer->data(), 0);
-    m_Profiler.Stop("meta_gather");
+        if (m_Comm.Rank() == 0)
+        {
+            uint64_t TotalSize = 0;
+            for (auto &n : RecvCounts)
+                TotalSize += n;
+            RecvBuffer->resize(TotalSize);
+        }
+
+        m_Profiler.Start("meta_gather");
+        m_Comm.GathervArrays(MetaBuffer.data(), LocalSize, RecvCounts.data(),
+                             RecvCounts.size(), RecvBuffer->data(), 0);
+        m_Profiler.Stop("meta_gather");
+    }
 
     if (m_Comm.Rank() == 0)
     {
@@ -518,7 +564,8 @@ void BP5Writer::EndStep()
         std::vector<core::iovec> AttributeBlocks;
         auto Metadata = m_BP5Serializer.BreakoutContiguousMetadata(
             RecvBuffer, RecvCounts, UniqueMetaMetaBlocks, AttributeBlocks,
-            DataSizes, m_WriterDataPos);
+            DataSizes, m_WriterDataPos,
+            m_TwoLevelMetadata ? &m_MetadataRankOrder : nullptr);
         if (m_MetaDataPos == 0)
         {
             //  First time, write the headers
@@ -535,6 +582,10 @@ void BP5Writer::EndStep()
                                                   sizeof(m_Assignment[0]) *
                                                       m_Assignment.size());
         }
+        if (m_BP5Serializer.m_MetadataKeyframeInterval > 0)
+        {
+            ResolveMetadataKeyframes(Metadata, *RecvBuffer);
+        }
         WriteMetaMetadata(UniqueMetaMetaBlocks);
         m_LatestMetaDataPos = m_MetaDataPos;
         m_LatestMetaDataSize = WriteMetadata(Metadata, AttributeBlocks);
@@ -572,10 +623,89 @@ void BP5Writer::Init()
     m_RankMPI = m_Comm.Rank();
     InitParameters();
     InitAggregator();
+    InitMetadataAggregation();
     InitTransports();
     InitBPBuffer();
 }
 
+void BP5Writer::InitMetadataAggregation()
+{
+    m_TwoLevelMetadata = m_Parameters.TwoLevelMetadata && (m_Comm.Size() > 1);
+    if (!m_TwoLevelMetadata)
+    {
+        return;
+    }
+    m_MetadataNodeComm =
+        m_Comm.GroupByShm("creating node communicator for metadata");
+    const bool isNodeLeader = (m_MetadataNodeComm.Rank() == 0);
+    // rank 0 is the leader of its node and rank 0 of the leaders
+    m_MetadataLeaderComm =
+        m_Comm.Split(isNodeLeader ? 0 : 1, m_Comm.Rank(),
+                     "creating node leaders communicator for metadata");
+
+    // rank 0 needs to know which rank's metadata arrives where
+    const std::vector<size_t> nodeRanks = m_MetadataNodeComm.GatherValues(
+        static_cast<size_t>(m_Comm.Rank()), 0);
+    if (isNodeLeader)
+    {
+        m_MetadataNodeSizes = m_MetadataLeaderComm.GatherValues(
+            static_cast<size_t>(nodeRanks.size()), 0);
+        if (m_Comm.Rank() == 0)
+        {
+            m_MetadataRankOrder.resize(m_Comm.Size());
+        }
+        m_MetadataLeaderComm.GathervArrays(
+            nodeRanks.data(), nodeRanks.size(), m_MetadataNodeSizes.data(),
+            m_MetadataNodeSizes.size(), m_MetadataRankOrder.data(), 0);
+    }
+}
+
+void BP5Writer::GatherMetadataTwoLevel(const std::vector<char> &MetaBuffer,
+                                       std::vector<size_t> &RecvCounts,
+                                       std::vector<char> &RecvBuffer)
+{
+    // first level: all ranks of a node to the node leader
+    std::vector<size_t> nodeCounts =
+        m_MetadataNodeComm.GatherValues(MetaBuffer.size(), 0);
+    std::vector<char> nodeBuffer;
+    if (m_MetadataNodeComm.Rank() == 0)
+    {
+        nodeBuffer.resize(
+            std::accumulate(nodeCounts.begin(), nodeCounts.end(), size_t(0)));
+    }
+    m_MetadataNodeComm.GathervArrays(MetaBuffer.data(), MetaBuffer.size(),
+                                     nodeCounts.data(), nodeCounts.size(),
+                                     nodeBuffer.data(), 0);
+    if (m_MetadataNodeComm.Rank() != 0)
+    {
+        return;
+    }
+    // ranks of a node mostly define the same variables
+    m_BP5Serializer.DeduplicateContiguousMetadata(nodeBuffer, nodeCounts);
+
+    // second level: node leaders to rank 0
+    std::vector<size_t> counts;
+    if (m_Comm.Rank() == 0)
+    {
+        counts.resize(m_Comm.Size());
+    }
+    m_MetadataLeaderComm.GathervArrays(
+        nodeCounts.data(), nodeCounts.size(), m_MetadataNodeSizes.data(),
+        m_MetadataNodeSizes.size(), counts.data(), 0);
+    const std::vector<size_t> nodeTotals =
+        m_MetadataLeaderComm.GatherValues(nodeBuffer.size(), 0);
+    if (m_Comm.Rank() == 0)
+    {
+        RecvBuffer.resize(
+            std::accumulate(nodeTotals.begin(), nodeTotals.end(), size_t(0)));
+    }
+    m_MetadataLeaderComm.GathervArrays(nodeBuffer.data(), nodeBuffer.size(),
+                                       nodeTotals.data(), nodeTotals.size(),
+                                       RecvBuffer.data(), 0);
+    // the blocks stay in node order, m_MetadataRankOrder maps them to ranks
+    RecvCounts = std::move(counts);
+}
+
 void BP5Writer::InitParameters()
 {
     ParseParams(m_IO, m_Parameters);
@@ -605,6 +735,31 @@ void BP5Writer::InitParameters()
     m_Parameters.NumSubFiles = helper::SetWithinLimit(
         m_Parameters.NumSubFiles, 0U, m_Parameters.NumAggregators);
 
+    m_BP5Serializer.m_MetadataKeyframeInterval =
+        m_Parameters.MetadataKeyframeInterval;
+    m_BP5Serializer.m_DataChecksum = m_Parameters.DataChecksum;
+
+    // sub-block division assumes row-major layout of the block in memory
+    if (m_IO.m_ArrayOrder != ArrayOrdering::ColumnMajor)
+    {
+        m_BP5Serializer.m_StatsBlockSize = m_Parameters.StatsBlockSize;
+    }
+
+    // older readers can't skip the sub-block statistics or checksum fields
+    // or expand delta encoded metadata
+    if (m_BP5Serializer.m_DataChecksum)
+    {
+        m_BPMinorVersion = m_BPMinorVersionChecksum;
+    }
+    else if (m_BP5Serializer.m_MetadataKeyframeInterval > 0)
+    {
+        m_BPMinorVersion = m_BPMinorVersionDelta;
+    }
+    else if (m_BP5Serializer.m_StatsBlockSize > 0)
+    {
+        m_BPMinorVersion = m_BPMinorVersionStats;
+    }
+
     // Limiting to max 64MB page size
     m_Parameters.StripeSize =
         helper::SetWithinLimit(m_Parameters.StripeSize, 0U, 67108864U);
@@ -680,6 +835,19 @@ uint64_t BP5Writer::CountStepsInMetadataIndex(format::BufferSTL &bufferSTL)
                 std::to_string(Version) + " version");
     }
 
+    position = m_BPMinorVersionPosition;
+    m_AppendBPMinorVersion =
+        helper::ReadValue<uint8_t>(buffer, position, IsLittleEndian);
+    if (m_AppendBPMinorVersion > m_BPMinorVersionMax)
+    {
+        helper::Throw<std::runtime_error>(
+            "Engine", "BP5Writer", "CountStepsInMetadataIndex",
+            "ADIOS2 BP5 Engine can't append to a file of bp format minor "
+            "version " +
+                std::to_string(m_AppendBPMinorVersion) +
+                ", it was written by a newer version of ADIOS2");
+    }
+
     position = m_ColumnMajorFlagPosition;
     const uint8_t columnMajor =
         helper::ReadValue<uint8_t>(buffer, position, IsLittleEndian);
@@ -696,6 +864,19 @@ uint64_t BP5Writer::CountStepsInMetadataIndex(format::BufferSTL &bufferSTL)
                 m + " major");
     }
 
+    // delta encoded metadata is a property of the whole file
+    position = m_MetadataDeltaFlagPosition;
+    const uint8_t metadataDeltas =
+        helper::ReadValue<uint8_t>(buffer, position, IsLittleEndian);
+    if (metadataDeltas != 'y')
+    {
+        m_BP5Serializer.m_MetadataKeyframeInterval = 0;
+    }
+    else if (m_BP5Serializer.m_MetadataKeyframeInterval == 0)
+    {
+        m_BP5Serializer.m_MetadataKeyframeInterval = 1;
+    }
+
     position = m_IndexHeaderSize; // after the header
     // Just count the steps first
     unsigned int availableSteps = 0;
@@ -1130,7 +1311,7 @@ void BP5Writer::MakeHeader(format::BufferSTL &b, const std::string fileType,
     const uint8_t version = 5;
     helper::CopyToBuffer(buffer, position, &version);
 
-    // byte 38: BP Minor version 1
+    // byte 38: BP Minor version
     if (position != m_BPMinorVersionPosition)
     {
         helper::Throw<std::runtime_error>(
@@ -1138,8 +1319,7 @@ void BP5Writer::MakeHeader(format::BufferSTL &b, const std::string fileType,
             "ADIOS Coding ERROR in BP5Writer::MakeHeader. BP Minor version "
             "position mismatch");
     }
-    const uint8_t minorversion = 1;
-    helper::CopyToBuffer(buffer, position, &minorversion);
+    helper::CopyToBuffer(buffer, position, &m_BPMinorVersion);
 
     // byte 39: Active flag (used in Index Table only)
     if (position != m_ActiveFlagPosition)
@@ -1158,8 +1338,13 @@ void BP5Writer::MakeHeader(format::BufferSTL &b, const std::string fileType,
         (m_IO.m_ArrayOrder == ArrayOrdering::ColumnMajor) ? 'y' : 'n';
     helper::CopyToBuffer(buffer, position, &columnMajor);
 
-    // byte 41-63: unused
-    position += 23;
+    // byte 41 metadata blocks are delta encoded
+    const uint8_t metadataDeltas =
+        (m_BP5Serializer.m_MetadataKeyframeInterval > 0) ? 'y' : 'n';
+    helper::CopyToBuffer(buffer, position, &metadataDeltas);
+
+    // byte 42-63: unused
+    position += 22;
     absolutePosition = position;
 }
 
@@ -1182,6 +1367,25 @@ void BP5Writer::UpdateActiveFlag(const bool active)
     }
 }
 
+void BP5Writer::UpdateMinorVersion()
+{
+    const char minorVersion = static_cast<char>(m_BPMinorVersion);
+    m_FileMetadataIndexManager.WriteFileAt(&minorVersion, 1,
+                                           m_BPMinorVersionPosition);
+    m_FileMetadataIndexManager.FlushFiles();
+    m_FileMetadataIndexManager.SeekToFileEnd();
+    if (m_DrainBB)
+    {
+        for (size_t i = 0; i < m_MetadataIndexFileNames.size(); ++i)
+        {
+            m_FileDrainer.AddOperationWriteAt(m_DrainMetadataIndexFileNames[i],
+                                              m_BPMinorVersionPosition, 1,
+                                              &minorVersion);
+            m_FileDrainer.AddOperationSeekEnd(m_DrainMetadataIndexFileNames[i]);
+        }
+    }
+}
+
 void BP5Writer::InitBPBuffer()
 {
     if (m_OpenMode == Mode::Append)
@@ -1252,6 +1456,12 @@ void BP5Writer::InitBPBuffer()
             // to indicate a new run begins
             UpdateActiveFlag(true);
 
+            // the appended steps may need a newer reader
+            if (m_BPMinorVersion > m_AppendBPMinorVersion)
+            {
+                UpdateMinorVersion();
+            }
+
             // Truncate existing index file
             if (m_AppendMetadataIndexPos < MaxSizeT)
             {
@@ -1354,7 +1564,7 @@ void BP5Writer::FlushData(const bool isFinal)
             new MallocV("BP5Writer", false, m_BP5Serializer.m_BufferAlign,
                         m_BP5Serializer.m_BufferBlockSize,
                         m_Parameters.InitialBufferSize,
-                        m_Parameters.GrowthFactor),
+                        m_Parameters.GrowthFactor, m_Parameters.Threads),
             m_Parameters.AsyncWrite || m_Parameters.DirectIO);
     }
     else
@@ -1362,7 +1572,7 @@ void BP5Writer::FlushData(const bool isFinal)
         DataBuf = m_BP5Serializer.ReinitStepData(
             new ChunkV("BP5Writer", false, m_BP5Serializer.m_BufferAlign,
                        m_BP5Serializer.m_BufferBlockSize,
-                       m_Parameters.BufferChunkSize),
+                       m_Parameters.BufferChunkSize, m_Parameters.Threads),
             m_Parameters.AsyncWrite || m_Parameters.DirectIO);
     }
 
@@ -163,6 +163,27 @@ private:
     uint64_t WriteMetadata(const std::vector<core::iovec> &MetaDataBlocks,
                            const std::vector<core::iovec> &AttributeBlocks);
 
+    /* TwoLevelMetadata: metadata is gathered on each node first and the node
+     * leaders send it on to rank 0 without duplicate meta-meta blocks */
+    bool m_TwoLevelMetadata = false;
+    helper::Comm m_MetadataNodeComm;
+    helper::Comm m_MetadataLeaderComm;
+    std::vector<size_t> m_MetadataNodeSizes; // rank 0: ranks per node
+    std::vector<size_t> m_MetadataRankOrder; // rank 0: ranks in gather order
+    void InitMetadataAggregation();
+
+    /* MetadataKeyframeInterval: position in md.0 of the last keyframe
+     * metadata block of each writer rank, rank 0 only */
+    std::vector<uint64_t> m_MetadataKeyframePos;
+    /* fills in the keyframe position of the delta blocks, which point into
+     * Aggregate */
+    void
+    ResolveMetadataKeyframes(const std::vector<core::iovec> &MetaDataBlocks,
+                             std::vector<char> &Aggregate);
+    void GatherMetadataTwoLevel(const std::vector<char> &MetaBuffer,
+                                std::vector<size_t> &RecvCounts,
+                                std::vector<char> &RecvBuffer);
+
     /** Write Data to disk, in an aggregator chain */
     void WriteData(format::BufferV *Data);
     void WriteData_EveryoneWrites(format::BufferV *Data,
@@ -180,6 +201,10 @@ private:
 
     void UpdateActiveFlag(const bool active);
 
+    /** minor version written in the header, see m_BPMinorVersionMax */
+    uint8_t m_BPMinorVersion = m_BPMinorVersionBase;
+    void UpdateMinorVersion();
+
     void WriteCollectiveMetadataFile(const bool isFinal = false);
 
     void MarshalAttributes();
@@ -250,6 +275,7 @@ private:
     uint32_t m_AppendWriterCount;         // last active number of writers
     unsigned int m_AppendAggregatorCount; // last active number of aggr
     unsigned int m_AppendSubfileCount;    // last active number of subfiles
+    uint8_t m_AppendBPMinorVersion = m_BPMinorVersionBase; // existing file
     /* Process existing index, fill in append variables,
      * and return the actual step we land after appending.
      * Uses parameter AppendAfterStep
@@ -65,7 +65,7 @@ void BP5Writer::WriteData_TwoLevelShm(format::BufferV *Data)
             alignment_size = m_Parameters.DirectIOAlignOffset;
         }
         a->CreateShm(static_cast<size_t>(maxSize), m_Parameters.MaxShmSize,
-                     alignment_size);
+                     alignment_size, m_Parameters.NumShmBuffers);
     }
 
     shm::TokenChain<uint64_t> tokenChain(&a->m_Comm);
@@ -202,7 +202,7 @@ void BP5Writer::WriteData_TwoLevelShm_Async(format::BufferV *Data)
             alignment_size = m_Parameters.DirectIOAlignOffset;
         }
         a->CreateShm(static_cast<size_t>(maxSize), m_Parameters.MaxShmSize,
-                     alignment_size);
+                     alignment_size, m_Parameters.NumShmBuffers);
     }
 
     if (a->m_IsAggregator)
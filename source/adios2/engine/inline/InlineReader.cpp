@@ -30,6 +30,7 @@ InlineReader::InlineReader(IO &io, const std::string &name, const Mode mode,
     PERFSTUBS_SCOPED_TIMER("InlineReader::Open");
     m_ReaderRank = m_Comm.Rank();
     Init();
+    FindWriter();
     if (m_Verbosity == 5)
     {
         std::cout << "Inline Reader " << m_ReaderRank << " Open(" << m_Name
@@ -37,31 +38,81 @@ InlineReader::InlineReader(IO &io, const std::string &name, const Mode mode,
     }
 }
 
-const InlineWriter *InlineReader::GetWriter() const
+InlineReader::~InlineReader()
 {
-    const auto &engine_map = m_IO.GetEngines();
-    if (engine_map.size() != 2)
+    const auto channel = std::atomic_load(&m_Channel);
+    if (channel)
     {
-        helper::Throw<std::runtime_error>(
-            "Engine", "InlineReader", "GetWriter",
-            "There must be exactly one reader and one "
-            "writer for the inline engine.");
+        channel->RemoveReader(this);
     }
+}
 
-    std::shared_ptr<Engine> e = engine_map.begin()->second;
-    if (e->OpenMode() == adios2::Mode::Read)
+void InlineReader::FindWriter()
+{
+    IO &writerIO = m_WriterIO.empty() ? m_IO : m_IO.m_ADIOS.AtIO(m_WriterIO);
+    if (writerIO.m_ArrayOrder != m_IO.m_ArrayOrder)
     {
-        e = engine_map.rbegin()->second;
+        // blocks are viewed and copied as they were put
+        helper::Throw<std::invalid_argument>(
+            "Engine", "InlineReader", "FindWriter",
+            "IO " + m_IO.m_Name + " of reader " + m_Name +
+                " must have the array order of the writer's IO " +
+                writerIO.m_Name);
+    }
+    for (const auto &pair : writerIO.GetEngines())
+    {
+        if (pair.second->OpenMode() != adios2::Mode::Write)
+        {
+            continue;
+        }
+        const auto writer =
+            dynamic_cast<const InlineWriter *>(pair.second.get());
+        if (!writer)
+        {
+            helper::Throw<std::runtime_error>(
+                "Engine", "InlineReader", "FindWriter",
+                "dynamic_cast<InlineWriter*> failed; this is very likely a "
+                "bug.");
+        }
+        if (m_WriterIO.empty() && writer->IsPipelined())
+        {
+            helper::Throw<std::invalid_argument>(
+                "Engine", "InlineReader", "FindWriter",
+                "reader " + m_Name + " shares IO " + m_IO.m_Name +
+                    " with a Pipelined writer; open pipelined readers on "
+                    "their own IO with parameter WriterIO=" +
+                    m_IO.m_Name);
+        }
+        AttachChannel(writer->Channel());
+        return;
     }
+    // a writer opened later on the same IO attaches this reader
+    if (!m_WriterIO.empty())
+    {
+        helper::Throw<std::runtime_error>(
+            "Engine", "InlineReader", "FindWriter",
+            "the inline writer must be opened on IO " + m_WriterIO +
+                " before reader " + m_Name);
+    }
+}
+
+void InlineReader::AttachChannel(std::shared_ptr<InlineChannel> channel)
+{
+    channel->AddReader(this);
+    std::atomic_store(&m_Channel, std::move(channel));
+}
 
-    const auto writer = dynamic_cast<InlineWriter *>(e.get());
-    if (!writer)
+InlineChannel &InlineReader::Channel() const
+{
+    const auto channel = std::atomic_load(&m_Channel);
+    if (!channel)
     {
         helper::Throw<std::runtime_error>(
-            "Engine", "InlineReader", "GetWriter",
-            "dynamic_cast<InlineWriter*> failed; this is very likely a bug.");
+            "Engine", "InlineReader", "Channel",
+            "There must be one writer for the inline engine.");
     }
-    return writer;
+    // m_Channel keeps it alive, it is never reset
+    return *channel;
 }
 
 StepStatus InlineReader::BeginStep(const StepMode mode,
@@ -75,18 +126,22 @@ StepStatus InlineReader::BeginStep(const StepMode mode,
             "InlineReader::BeginStep was called but the "
             "reader is already inside a step");
     }
-    // Reader should be on step that writer just completed
-    auto writer = GetWriter();
-    if (writer->IsInsideStep())
+    // Reader moves to the last step the writer completed. Check for the end
+    // of stream first: the writer publishes its last step before closing.
+    auto &channel = Channel();
+    const bool writerClosed = channel.Closed;
+    auto step = channel.Published();
+    if (!step || step->Step == static_cast<size_t>(-1) ||
+        (m_CurrentStep != static_cast<size_t>(-1) &&
+         step->Step <= m_CurrentStep))
     {
-        m_InsideStep = false;
-        return StepStatus::NotReady;
+        return writerClosed ? StepStatus::EndOfStream : StepStatus::NotReady;
     }
-    m_CurrentStep = writer->CurrentStep();
-    if (m_CurrentStep == static_cast<size_t>(-1))
+    m_Step = std::move(step);
+    m_CurrentStep = m_Step->Step;
+    if (!m_WriterIO.empty())
     {
-        m_InsideStep = false;
-        return StepStatus::EndOfStream;
+        DefineStepVariables();
     }
     m_InsideStep = true;
 
@@ -106,16 +161,21 @@ void InlineReader::PerformGets()
     {
         std::cout << "Inline Reader " << m_ReaderRank << "     PerformGets()\n";
     }
-    SetDeferredVariablePointers();
+    RunDeferredGets();
 }
 
 size_t InlineReader::CurrentStep() const
 {
-    // Reader should be on same step as writer
+    if (m_InsideStep)
+    {
+        return m_CurrentStep;
+    }
+    // Outside of steps reader should be on same step as writer
     // added here since it's not really necessary to use beginstep/endstep for
     // this engine's reader so this ensures we do report the correct step
-    const auto writer = GetWriter();
-    return writer->CurrentStep();
+    const InlineChannel &channel = Channel();
+    return channel.Closed ? static_cast<size_t>(-1)
+                          : channel.WriterStep.load();
 }
 
 void InlineReader::EndStep()
@@ -133,15 +193,21 @@ void InlineReader::EndStep()
         std::cout << "Inline Reader " << m_ReaderRank << " EndStep() Step "
                   << m_CurrentStep << std::endl;
     }
-    if (!m_DeferredVariables.empty())
-    {
-        SetDeferredVariablePointers();
-    }
+    RunDeferredGets();
     m_InsideStep = false;
 }
 
 bool InlineReader::IsInsideStep() const { return m_InsideStep; }
 
+size_t InlineReader::LastBegunStep() const noexcept { return m_CurrentStep; }
+
+bool InlineReader::IsClosed() const noexcept { return m_Closed; }
+
+bool InlineReader::SharesWriterIO() const noexcept
+{
+    return m_WriterIO.empty();
+}
+
 // PRIVATE
 
 #define declare_type(T)                                                        \
@@ -187,7 +253,9 @@ ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
         const Variable<T> &variable, const size_t step) const                  \
     {                                                                          \
         PERFSTUBS_SCOPED_TIMER("InlineReader::DoBlocksInfo");                  \
-        return variable.m_BlocksInfo;                                          \
+        const auto active = ActiveStep();                                      \
+        const auto blocks = StepBlocks(active.get(), variable);                \
+        return blocks ? *blocks : std::vector<typename Variable<T>::BPInfo>(); \
     }
 
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
@@ -218,6 +286,10 @@ void InlineReader::InitParameters()
                     "integer in the range [0,5], in call to "
                     "Open or Engine constructor");
         }
+        else if (key == "writerio" && value != m_IO.m_Name)
+        {
+            m_WriterIO = value;
+        }
     }
 }
 
@@ -234,37 +306,56 @@ void InlineReader::DoClose(const int transportIndex)
         std::cout << "Inline Reader " << m_ReaderRank << " Close(" << m_Name
                   << ")\n";
     }
+    m_DeferredGets.clear();
+    m_Step.reset();
+    m_InsideStep = false;
+    m_Closed = true;
+    const auto channel = std::atomic_load(&m_Channel);
+    if (channel)
+    {
+        channel->RemoveReader(this);
+    }
 }
 
-void InlineReader::SetDeferredVariablePointers()
+void InlineReader::DefineStepVariables()
 {
-    // need to set core::Variable::BPInfo::BufferP for each deferred variable
-    // to the ptr stored in core::Variable::BPInfo::Data
-    // this will make Variable::BPInfo::Data() work correctly for the user
-    for (const auto &varName : m_DeferredVariables)
+    for (const auto &pair : m_Step->Variables)
     {
-        const DataType type = m_IO.InquireVariableType(varName);
+        const DataType type = pair.second.Type;
         if (type == DataType::Compound)
         {
         }
 #define declare_type(T)                                                        \
     else if (type == helper::GetDataType<T>())                                 \
     {                                                                          \
-        Variable<T> &variable =                                                \
-            FindVariable<T>(varName, "in call to EndStep");                    \
-        for (auto &info : variable.m_BlocksInfo)                               \
-        {                                                                      \
-            info.BufferP = info.Data;                                          \
-        }                                                                      \
+        DefineStepVariable<T>(pair.first, pair.second);                        \
     }
         ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 #undef declare_type
     }
-    m_DeferredVariables.clear();
+}
+
+std::shared_ptr<InlineStep> InlineReader::ActiveStep() const
+{
+    if (m_InsideStep)
+    {
+        return m_Step;
+    }
+    return Channel().Published();
+}
+
+void InlineReader::RunDeferredGets()
+{
+    for (auto &get : m_DeferredGets)
+    {
+        get();
+    }
+    m_DeferredGets.clear();
 }
 
 #define declare_type(T)                                                        \
-    template void InlineReader::Get<T>(Variable<T> &, T **) const;
+    template void InlineReader::Get<T>(Variable<T> &, T **, Box<Dims> *)       \
+        const;
 ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_type)
 #undef declare_type
 
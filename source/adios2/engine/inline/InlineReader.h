@@ -17,6 +17,11 @@
 #include "adios2/core/Engine.h"
 #include "adios2/helper/adiosComm.h"
 #include "adios2/helper/adiosFunctions.h"
+#include "InlineWriter.h" // InlineStep, InlineChannel
+
+#include <atomic>
+#include <functional>
+#include <memory>
 
 namespace adios2
 {
@@ -25,10 +30,6 @@ namespace core
 namespace engine
 {
 
-// The inline reader needs to know about the writer, and vice versa.
-// Break cyclic dependency via a forward declaration:
-class InlineWriter;
-
 class InlineReader : public Engine
 {
 public:
@@ -45,7 +46,7 @@ public:
     InlineReader(IO &adios, const std::string &name, const Mode mode,
                  helper::Comm comm);
 
-    ~InlineReader() = default;
+    ~InlineReader();
     StepStatus BeginStep(StepMode mode = StepMode::Read,
                          const float timeoutSeconds = -1.0) final;
     void PerformGets() final;
@@ -54,24 +55,77 @@ public:
 
     bool IsInsideStep() const;
 
+    /** last step begun by this reader, safe to call from the writer thread */
+    size_t LastBegunStep() const noexcept;
+
+    bool IsClosed() const noexcept;
+
+    /** true if the reader shares the IO, and so the variables, of the
+     * writer */
+    bool SharesWriterIO() const noexcept;
+
+    /** called by a writer opened on the reader's IO after the reader */
+    void AttachChannel(std::shared_ptr<InlineChannel> channel);
+
+    /**
+     * Zero-copy access to the writer's data. If the variable selection lies
+     * within a single block, data points at its first element inside that
+     * block and the selection is strided like the block (strides of the block
+     * Count in the array order of the IO), otherwise this throws.
+     * @param block if not nullptr, receives the global start (zeros for local
+     * arrays) and the count of that block
+     */
     template <typename T>
-    void Get(Variable<T> &, T **) const;
+    void Get(Variable<T> &, T **, Box<Dims> *block = nullptr) const;
+
+    /** step to read from: the current one, or the latest published one when
+     * used outside of BeginStep/EndStep. Holding it keeps the owners of its
+     * data alive, see InlineWriter::KeepAlive */
+    std::shared_ptr<InlineStep> ActiveStep() const;
 
 private:
-    const InlineWriter *GetWriter() const;
+    /** the writer's shared state, attached at Open so that it stays
+     * reachable after the writer is closed, throws if there is no writer */
+    InlineChannel &Channel() const;
+    /** set at Open of the reader or of the writer, whichever comes last,
+     * accessed with std::atomic_load/atomic_store */
+    std::shared_ptr<InlineChannel> m_Channel;
+
+    /** name of the IO of the writer if it is not m_IO. Variables are then
+     * defined in m_IO from the published steps, so that selections and
+     * variable state are not shared with other threads. */
+    std::string m_WriterIO;
+
     int m_Verbosity = 0;
     int m_ReaderRank; // my rank in the readers' comm
 
     // step info should be received from the writer side in BeginStep()
-    size_t m_CurrentStep = static_cast<size_t>(-1);
-    bool m_InsideStep = false;
-    std::vector<std::string> m_DeferredVariables;
+    std::atomic<size_t> m_CurrentStep{static_cast<size_t>(-1)};
+    std::atomic<bool> m_InsideStep{false};
+    std::atomic<bool> m_Closed{false};
+
+    /** step being read, kept until the next BeginStep so that returned
+     * block infos remain valid */
+    std::shared_ptr<InlineStep> m_Step;
+
+    /** copies queued by deferred Gets, run at PerformGets or EndStep */
+    std::vector<std::function<void()>> m_DeferredGets;
 
     void Init() final; ///< called from constructor, gets the selected Inline
                        /// transport method from settings
     void InitParameters() final;
     void InitTransports() final;
 
+    /** finds the writer in its IO, if already open, and attaches to it */
+    void FindWriter();
+
+    /** defines or updates the variables of m_Step in m_IO */
+    void DefineStepVariables();
+
+    template <class T>
+    void DefineStepVariable(const std::string &name,
+                            const InlineStep::VariableInfo &info);
+
 #define declare_type(T)                                                        \
     void DoGetSync(Variable<T> &, T *) final;                                  \
     void DoGetDeferred(Variable<T> &, T *) final;                              \
@@ -94,6 +148,16 @@ private:
     template <class T>
     typename Variable<T>::BPInfo *GetBlockDeferredCommon(Variable<T> &variable);
 
+    template <class T>
+    std::vector<typename Variable<T>::BPInfo> *
+    StepBlocks(const InlineStep *step, const Variable<T> &variable) const;
+
+    /** copy a selection out of the writer blocks of step into data */
+    template <class T>
+    void CopySelection(const InlineStep &step, const Variable<T> &variable,
+                       const SelectionType selectionType, const size_t blockID,
+                       const Dims &start, const Dims &count, T *data) const;
+
 #define declare_type(T)                                                        \
     std::map<size_t, std::vector<typename Variable<T>::BPInfo>>                \
     DoAllStepsBlocksInfo(const Variable<T> &variable) const final;             \
@@ -104,7 +168,7 @@ private:
     ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 #undef declare_type
 
-    void SetDeferredVariablePointers();
+    void RunDeferredGets();
 };
 
 } // end namespace engine
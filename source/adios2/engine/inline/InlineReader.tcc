@@ -31,66 +31,158 @@ inline void InlineReader::GetSyncCommon(Variable<T> &variable, T *data)
         std::cout << "Inline Reader " << m_ReaderRank << "     GetSync("
                   << variable.m_Name << ")\n";
     }
-    variable.m_Data = data;
-    auto blockInfo = variable.m_BlocksInfo.back();
-    if (blockInfo.IsValue)
+    const auto step = ActiveStep();
+    if (!step)
     {
-        *data = blockInfo.Value;
-    }
-    else
-    {
-        *data = blockInfo.Data[0];
+        helper::Throw<std::runtime_error>(
+            "Engine", "InlineReader", "GetSyncCommon",
+            "no step of variable " + variable.m_Name +
+                " was published by the writer yet");
     }
+    CopySelection(*step, variable, variable.m_SelectionType,
+                  variable.m_BlockID, variable.m_Start, variable.m_Count,
+                  data);
 }
 
 template <class T>
-void InlineReader::Get(core::Variable<T> &variable, T **data) const
+void InlineReader::Get(core::Variable<T> &variable, T **data,
+                       Box<Dims> *block) const
 {
     if (m_Verbosity == 5)
     {
         std::cout << "Inline Reader " << m_ReaderRank << "     Get("
                   << variable.m_Name << ")\n";
     }
-    auto blockInfo = variable.m_BlocksInfo.back();
-    *data = blockInfo.Data;
+    const auto step = ActiveStep();
+    const auto blocks = StepBlocks(step.get(), variable);
+    if (!blocks || blocks->empty())
+    {
+        helper::Throw<std::invalid_argument>(
+            "Engine", "InlineReader", "Get",
+            "variable " + variable.m_Name +
+                " has no blocks in the current step");
+    }
+    const bool isRowMajor = (m_IO.m_ArrayOrder == ArrayOrdering::RowMajor);
+    auto lf_SetBlock = [block](const typename Variable<T>::BPInfo &info) {
+        if (block)
+        {
+            block->first = info.Start.size() == info.Count.size()
+                               ? info.Start
+                               : Dims(info.Count.size(), 0);
+            block->second = info.Count;
+        }
+    };
+
+    if (variable.m_ShapeID == ShapeID::LocalArray ||
+        variable.m_SelectionType == SelectionType::WriteBlock)
+    {
+        if (variable.m_BlockID >= blocks->size())
+        {
+            helper::Throw<std::invalid_argument>(
+                "Engine", "InlineReader", "Get",
+                "selected BlockID " + std::to_string(variable.m_BlockID) +
+                    " is above range of available blocks");
+        }
+        const auto &info = (*blocks)[variable.m_BlockID];
+        size_t offset = 0;
+        if (variable.m_ShapeID == ShapeID::LocalArray &&
+            variable.m_Start.size() == info.Count.size())
+        {
+            // selection is relative to the block
+            offset = helper::LinearIndex(Dims(info.Count.size(), 0),
+                                         info.Count, variable.m_Start,
+                                         isRowMajor);
+        }
+        *data = info.Data + offset;
+        lf_SetBlock(info);
+        return;
+    }
+
+    if (variable.m_ShapeID != ShapeID::GlobalArray || variable.m_Count.empty())
+    {
+        *data = blocks->back().Data;
+        lf_SetBlock(blocks->back());
+        return;
+    }
+
+    // a bounding box is viewed in place if a single block contains it
+    const Dims &start = variable.m_Start;
+    const Dims &count = variable.m_Count;
+    for (const auto &info : *blocks)
+    {
+        bool contained = info.Start.size() == start.size();
+        for (size_t d = 0; contained && d < start.size(); ++d)
+        {
+            contained = info.Start[d] <= start[d] &&
+                        start[d] + count[d] <= info.Start[d] + info.Count[d];
+        }
+        if (contained)
+        {
+            *data = info.Data + helper::LinearIndex(info.Start, info.Count,
+                                                    start, isRowMajor);
+            lf_SetBlock(info);
+            return;
+        }
+    }
+    helper::Throw<std::invalid_argument>(
+        "Engine", "InlineReader", "Get",
+        "the selection of variable " + variable.m_Name +
+            " spans several blocks, it can't be viewed in place; use "
+            "Get(variable, T*) to copy it");
 }
 
 template <class T>
 void InlineReader::GetDeferredCommon(Variable<T> &variable, T *data)
 {
-    helper::Throw<std::runtime_error>(
-        "Engine", "InlineReader", "GetDeferredCommon",
-        "GetBlockDeferredCommon should be used instead of GetDeferredCommon.");
+    if (m_Verbosity == 5)
+    {
+        std::cout << "Inline Reader " << m_ReaderRank << "     GetDeferred("
+                  << variable.m_Name << ")\n";
+    }
+    auto step = ActiveStep();
+    if (!step)
+    {
+        helper::Throw<std::runtime_error>(
+            "Engine", "InlineReader", "GetDeferredCommon",
+            "no step of variable " + variable.m_Name +
+                " was published by the writer yet");
+    }
+    // the selection may change before PerformGets, capture it now
+    const SelectionType selectionType = variable.m_SelectionType;
+    const size_t blockID = variable.m_BlockID;
+    const Dims start = variable.m_Start;
+    const Dims count = variable.m_Count;
+    m_DeferredGets.emplace_back([this, step, &variable, selectionType, blockID,
+                                 start, count, data]() {
+        CopySelection(*step, variable, selectionType, blockID, start, count,
+                      data);
+    });
 }
 
 template <class T>
 inline typename Variable<T>::BPInfo *
 InlineReader::GetBlockSyncCommon(Variable<T> &variable)
 {
-    if (variable.m_BlockID >= variable.m_BlocksInfo.size())
-    {
-        helper::Throw<std::invalid_argument>(
-            "Engine", "InlineReader", "GetBlockSyncCommon",
-            "selected BlockID " + std::to_string(variable.m_BlockID) +
-                " is above range of available blocks in GetBlockSync");
-    }
     if (m_Verbosity == 5)
     {
         std::cout << "Inline Reader " << m_ReaderRank << "     GetBlockSync("
                   << variable.m_Name << ")\n";
     }
-    // Sync is okay when reading. Just need to make sure the pointer is
-    // available now.
-    variable.m_BlocksInfo[variable.m_BlockID].BufferP =
-        variable.m_BlocksInfo[variable.m_BlockID].Data;
-    return &variable.m_BlocksInfo[variable.m_BlockID];
+    // Sync and Deferred are the same when reading: the snapshot published by
+    // the writer already points at the data.
+    return GetBlockDeferredCommon(variable);
 }
 
 template <class T>
 inline typename Variable<T>::BPInfo *
 InlineReader::GetBlockDeferredCommon(Variable<T> &variable)
 {
-    if (variable.m_BlockID >= variable.m_BlocksInfo.size())
+    if (!m_InsideStep)
+    {
+        m_Step = ActiveStep();
+    }
+    const auto blocks = StepBlocks(m_Step.get(), variable);
+    if (!blocks || variable.m_BlockID >= blocks->size())
     {
         helper::Throw<std::invalid_argument>(
             "Engine", "InlineReader", "GetBlockDeferredCommon",
@@ -102,8 +194,137 @@ InlineReader::GetBlockDeferredCommon(Variable<T> &variable)
         std::cout << "Inline Reader " << m_ReaderRank
                   << "     GetBlockDeferred(" << variable.m_Name << ")\n";
     }
-    m_DeferredVariables.push_back(variable.m_Name);
-    return &variable.m_BlocksInfo[variable.m_BlockID];
+    return &(*blocks)[variable.m_BlockID];
+}
+
+template <class T>
+void InlineReader::DefineStepVariable(const std::string &name,
+                                      const InlineStep::VariableInfo &info)
+{
+    Variable<T> *variable = m_IO.InquireVariable<T>(name);
+    if (variable)
+    {
+        if (info.ShapeType == ShapeID::GlobalArray)
+        {
+            variable->m_Shape = info.Shape;
+        }
+        return;
+    }
+
+    switch (info.ShapeType)
+    {
+    case ShapeID::GlobalValue:
+        m_IO.DefineVariable<T>(name);
+        break;
+    case ShapeID::LocalValue:
+        m_IO.DefineVariable<T>(name, {LocalValueDim});
+        break;
+    case ShapeID::GlobalArray:
+        m_IO.DefineVariable<T>(name, info.Shape, Dims(info.Shape.size(), 0),
+                               info.Shape);
+        break;
+    case ShapeID::LocalArray:
+    {
+        // the count of the first block, readers select blocks by BlockID
+        const auto it = m_Step->Blocks.find(name);
+        const auto *blocks =
+            static_cast<const std::vector<typename Variable<T>::BPInfo> *>(
+                it->second.get());
+        const Dims count = blocks->empty() ? Dims() : blocks->front().Count;
+        m_IO.DefineVariable<T>(name, {}, {}, count);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+template <class T>
+std::vector<typename Variable<T>::BPInfo> *
+InlineReader::StepBlocks(const InlineStep *step,
+                         const Variable<T> &variable) const
+{
+    if (!step)
+    {
+        return nullptr;
+    }
+    auto it = step->Blocks.find(variable.m_Name);
+    if (it == step->Blocks.end())
+    {
+        return nullptr;
+    }
+    return static_cast<std::vector<typename Variable<T>::BPInfo> *>(
+        it->second.get());
+}
+
+template <class T>
+void InlineReader::CopySelection(const InlineStep &step,
+                                 const Variable<T> &variable,
+                                 const SelectionType selectionType,
+                                 const size_t blockID, const Dims &start,
+                                 const Dims &count, T *data) const
+{
+    const auto blocks = StepBlocks(&step, variable);
+    if (!blocks || blocks->empty())
+    {
+        helper::Throw<std::invalid_argument>(
+            "Engine", "InlineReader", "CopySelection",
+            "variable " + variable.m_Name +
+                " has no blocks in the current step");
+    }
+
+    if (blocks->back().IsValue)
+    {
+        *data = blocks->back().Value;
+        return;
+    }
+    // blocks and selection are in the array order of the IO. The col-major
+    // to col-major path of NdCopy takes the last dimension as the fastest,
+    // so column-major dimensions are reversed and copied as row-major.
+    const bool isRowMajor = (m_IO.m_ArrayOrder == ArrayOrdering::RowMajor);
+    auto lf_RowMajor = [isRowMajor](const Dims &dims) {
+        return isRowMajor ? dims : Dims(dims.rbegin(), dims.rend());
+    };
+
+    if (variable.m_ShapeID == ShapeID::LocalArray ||
+        selectionType == SelectionType::WriteBlock)
+    {
+        if (blockID >= blocks->size())
+        {
+            helper::Throw<std::invalid_argument>(
+                "Engine", "InlineReader", "CopySelection",
+                "selected BlockID " + std::to_string(blockID) +
+                    " is above range of available blocks");
+        }
+        const auto &info = (*blocks)[blockID];
+        if (variable.m_ShapeID == ShapeID::LocalArray &&
+            start.size() == info.Count.size() &&
+            count.size() == info.Count.size())
+        {
+            // selection is relative to the block
+            helper::NdCopy<T>(reinterpret_cast<const char *>(info.Data),
+                              Dims(info.Count.size(), 0),
+                              lf_RowMajor(info.Count), true, true,
+                              reinterpret_cast<char *>(data),
+                              lf_RowMajor(start), lf_RowMajor(count), true,
+                              true);
+        }
+        else
+        {
+            std::copy(info.Data, info.Data + helper::GetTotalSize(info.Count),
+                      data);
+        }
+        return;
+    }
+
+    for (const auto &info : *blocks)
+    {
+        // NdCopy skips blocks that do not intersect the selection
+        helper::NdCopy<T>(reinterpret_cast<const char *>(info.Data),
+                          lf_RowMajor(info.Start), lf_RowMajor(info.Count),
+                          true, true, reinterpret_cast<char *>(data),
+                          lf_RowMajor(start), lf_RowMajor(count), true, true);
+    }
 }
 
 } // end namespace engine
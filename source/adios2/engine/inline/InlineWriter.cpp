@@ -15,6 +15,7 @@
 #include "adios2/helper/adiosFunctions.h"
 #include <adios2-perfstubs-interface.h>
 
+#include <algorithm>
 #include <iostream>
 
 namespace adios2
@@ -24,6 +25,37 @@ namespace core
 namespace engine
 {
 
+void InlineChannel::AddReader(const InlineReader *reader)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (std::find(m_Readers.begin(), m_Readers.end(), reader) ==
+        m_Readers.end())
+    {
+        m_Readers.push_back(reader);
+    }
+}
+
+void InlineChannel::RemoveReader(const InlineReader *reader)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Readers.erase(std::remove(m_Readers.begin(), m_Readers.end(), reader),
+                    m_Readers.end());
+}
+
+bool InlineChannel::AnyReader(
+    const std::function<bool(const InlineReader &)> &predicate) const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (const InlineReader *reader : m_Readers)
+    {
+        if (predicate(*reader))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 InlineWriter::InlineWriter(IO &io, const std::string &name, const Mode mode,
                            helper::Comm comm)
 : Engine("InlineWriter", io, name, mode, std::move(comm))
@@ -31,6 +63,7 @@ InlineWriter::InlineWriter(IO &io, const std::string &name, const Mode mode,
     PERFSTUBS_SCOPED_TIMER("InlineWriter::Open");
     m_WriterRank = m_Comm.Rank();
     Init();
+    AttachReaders();
     if (m_Verbosity == 5)
     {
         std::cout << "Inline Writer " << m_WriterRank << " Open(" << m_Name
@@ -38,31 +71,33 @@ InlineWriter::InlineWriter(IO &io, const std::string &name, const Mode mode,
     }
 }
 
-const InlineReader *InlineWriter::GetReader() const
+void InlineWriter::AttachReaders()
 {
-    const auto &engine_map = m_IO.GetEngines();
-    if (engine_map.size() != 2)
+    for (const auto &pair : m_IO.GetEngines())
     {
-        helper::Throw<std::runtime_error>(
-            "Engine", "InlineWriter", "GetReader",
-            "There must be exactly one reader and one "
-            "writer for the inline engine.");
-    }
-
-    std::shared_ptr<Engine> e = engine_map.begin()->second;
-    if (e->OpenMode() == adios2::Mode::Write)
-    {
-        e = engine_map.rbegin()->second;
-    }
-
-    const auto reader = dynamic_cast<InlineReader *>(e.get());
-    if (!reader)
-    {
-        helper::Throw<std::runtime_error>(
-            "Engine", "InlineWriter", "GetReader",
-            "dynamic_cast<InlineReader*> failed; this is very likely a bug.");
+        if (pair.second->OpenMode() != adios2::Mode::Read)
+        {
+            continue;
+        }
+        const auto reader = dynamic_cast<InlineReader *>(pair.second.get());
+        if (!reader)
+        {
+            helper::Throw<std::runtime_error>(
+                "Engine", "InlineWriter", "AttachReaders",
+                "dynamic_cast<InlineReader*> failed; this is very likely a "
+                "bug.");
+        }
+        if (m_Pipelined)
+        {
+            helper::Throw<std::invalid_argument>(
+                "Engine", "InlineWriter", "AttachReaders",
+                "reader " + reader->m_Name + " shares IO " + m_IO.m_Name +
+                    " with a Pipelined writer; open pipelined readers on "
+                    "their own IO with parameter WriterIO=" +
+                    m_IO.m_Name);
+        }
+        reader->AttachChannel(m_Channel);
     }
-    return reader;
 }
 
 StepStatus InlineWriter::BeginStep(StepMode mode, const float timeoutSeconds)
@@ -76,8 +111,26 @@ StepStatus InlineWriter::BeginStep(StepMode mode, const float timeoutSeconds)
             "writer is already inside a step");
     }
 
-    auto reader = GetReader();
-    if (reader->IsInsideStep())
+    // Without pipelining, the readers must be done with their step. With it,
+    // they only need to have begun the last published step, since they read
+    // from its snapshot while this step is produced.
+    const auto publishedStep = m_Channel->Published();
+    const size_t published =
+        publishedStep ? publishedStep->Step : static_cast<size_t>(-1);
+    const bool pipelined = m_Pipelined;
+    const bool notReady =
+        m_Channel->AnyReader([published, pipelined](const InlineReader &r) {
+            if (r.IsClosed())
+            {
+                return false;
+            }
+            const size_t readerStep = r.LastBegunStep();
+            const bool behind = published != static_cast<size_t>(-1) &&
+                                (readerStep == static_cast<size_t>(-1) ||
+                                 readerStep < published);
+            return pipelined ? behind : r.IsInsideStep();
+        });
+    if (notReady)
     {
         m_InsideStep = false;
         return StepStatus::NotReady;
@@ -91,6 +144,7 @@ StepStatus InlineWriter::BeginStep(StepMode mode, const float timeoutSeconds)
     {
         ++m_CurrentStep;
     }
+    m_Channel->WriterStep = m_CurrentStep;
     if (m_Verbosity == 5)
     {
         std::cout << "Inline Writer " << m_WriterRank
@@ -124,9 +178,71 @@ void InlineWriter::ResetVariables()
         ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 #undef declare_type
     }
+    m_Owners.clear();
     m_ResetVariables = false;
 }
 
+void InlineWriter::PublishStep()
+{
+    auto step = std::make_shared<InlineStep>();
+    step->Step = m_CurrentStep;
+
+    auto availVars = m_IO.GetAvailableVariables();
+    for (auto &varPair : availVars)
+    {
+        const auto &name = varPair.first;
+        const DataType type = m_IO.InquireVariableType(name);
+
+        if (type == DataType::Compound)
+        {
+        }
+#define declare_type(T)                                                        \
+    else if (type == helper::GetDataType<T>())                                 \
+    {                                                                          \
+        Variable<T> &variable = FindVariable<T>(name, "in call to EndStep");   \
+        if (variable.m_BlocksInfo.empty())                                     \
+        {                                                                      \
+            continue;                                                          \
+        }                                                                      \
+        auto blocks = std::make_shared<                                        \
+            std::vector<typename Variable<T>::BPInfo>>(variable.m_BlocksInfo); \
+        for (auto &info : *blocks)                                             \
+        {                                                                      \
+            info.BufferP = info.Data;                                          \
+        }                                                                      \
+        step->Blocks.emplace(name, std::move(blocks));                         \
+        InlineStep::VariableInfo &varInfo = step->Variables[name];             \
+        varInfo.Type = type;                                                   \
+        varInfo.ShapeType = variable.m_ShapeID;                                \
+        varInfo.Shape = variable.m_Shape;                                      \
+    }
+        ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+#undef declare_type
+    }
+
+    step->Owners = m_Owners;
+    m_Channel->Publish(std::move(step));
+}
+
+std::shared_ptr<InlineStep> InlineWriter::PublishedStep() const
+{
+    return m_Channel->Published();
+}
+
+bool InlineWriter::IsClosed() const noexcept { return m_Channel->Closed; }
+
+bool InlineWriter::IsPipelined() const noexcept { return m_Pipelined; }
+
+std::shared_ptr<InlineChannel> InlineWriter::Channel() const noexcept
+{
+    return m_Channel;
+}
+
+void InlineWriter::KeepAlive(std::shared_ptr<void> owner)
+{
+    m_Owners.push_back(std::move(owner));
+}
+
 size_t InlineWriter::CurrentStep() const { return m_CurrentStep; }
 
 void InlineWriter::PerformPuts()
@@ -136,6 +252,11 @@ void InlineWriter::PerformPuts()
     {
         std::cout << "Inline Writer " << m_WriterRank << "     PerformPuts()\n";
     }
+    // outside of steps, the blocks put so far are what readers get
+    if (!m_InsideStep)
+    {
+        PublishStep();
+    }
     m_ResetVariables = true;
 }
 
@@ -154,6 +275,7 @@ void InlineWriter::EndStep()
         std::cout << "Inline Writer " << m_WriterRank << " EndStep() Step "
                   << m_CurrentStep << std::endl;
     }
+    PublishStep();
     m_InsideStep = false;
 }
 
@@ -209,6 +331,12 @@ void InlineWriter::InitParameters()
                     "integer in the range [0,5], in call to "
                     "Open or Engine constructor");
         }
+        else if (key == "pipelined")
+        {
+            std::transform(value.begin(), value.end(), value.begin(),
+                           ::tolower);
+            m_Pipelined = (value == "yes" || value == "true" || value == "on");
+        }
     }
 }
 
@@ -225,8 +353,8 @@ void InlineWriter::DoClose(const int transportIndex)
         std::cout << "Inline Writer " << m_WriterRank << " Close(" << m_Name
                   << ")\n";
     }
-    // end of stream
-    m_CurrentStep = static_cast<size_t>(-1);
+    // end of stream, readers still get the last published step
+    m_Channel->Closed = true;
 }
 
 } // end namespace engine
@@ -16,6 +16,13 @@
 #include "adios2/core/Engine.h"
 #include "adios2/helper/adiosComm.h"
 
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 namespace adios2
 {
 namespace core
@@ -27,6 +34,69 @@ namespace engine
 // Break cyclic dependency via a forward declaration:
 class InlineReader;
 
+/**
+ * Blocks put by the writer in one step. Published at EndStep (or PerformPuts
+ * outside of steps) and never modified afterwards, so readers can keep using
+ * it while the writer moves on to the next step.
+ */
+struct InlineStep
+{
+    /** what a reader opened on another IO needs to define a variable */
+    struct VariableInfo
+    {
+        DataType Type = DataType::None;
+        ShapeID ShapeType = ShapeID::Unknown;
+        Dims Shape;
+    };
+
+    size_t Step = static_cast<size_t>(-1);
+    /** variable name -> std::vector<typename Variable<T>::BPInfo> */
+    std::unordered_map<std::string, std::shared_ptr<void>> Blocks;
+    std::unordered_map<std::string, VariableInfo> Variables;
+    /** keep the data of the blocks alive, see InlineWriter::KeepAlive */
+    std::vector<std::shared_ptr<void>> Owners;
+};
+
+/**
+ * State shared by the writer and its readers. Readers keep it after the
+ * writer engine is closed and removed from the IO, to see the end of stream.
+ * The writer only reaches its readers through here, never through the
+ * engines of an IO, so readers may be opened and closed on other threads.
+ */
+struct InlineChannel
+{
+    std::atomic<bool> Closed{false};
+
+    /** step the writer is in, reported by readers outside of steps */
+    std::atomic<size_t> WriterStep{static_cast<size_t>(-1)};
+
+    std::shared_ptr<InlineStep> Published() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Step;
+    }
+
+    void Publish(std::shared_ptr<InlineStep> step)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Step = std::move(step);
+    }
+
+    void AddReader(const InlineReader *reader);
+
+    void RemoveReader(const InlineReader *reader);
+
+    /** true if predicate holds for one of the readers. Evaluated under the
+     * lock, readers can't go away meanwhile. */
+    bool AnyReader(
+        const std::function<bool(const InlineReader &)> &predicate) const;
+
+private:
+    mutable std::mutex m_Mutex;
+    std::shared_ptr<InlineStep> m_Step;
+    std::vector<const InlineReader *> m_Readers;
+};
+
 class InlineWriter : public Engine
 {
 
@@ -52,6 +122,20 @@ public:
 
     bool IsInsideStep() const;
 
+    /** latest step published to the readers, nullptr if none yet */
+    std::shared_ptr<InlineStep> PublishedStep() const;
+
+    /** true once the writer is closed, the end of stream for readers */
+    bool IsClosed() const noexcept;
+
+    bool IsPipelined() const noexcept;
+
+    std::shared_ptr<InlineChannel> Channel() const noexcept;
+
+    /** owner of the data of the next Put, e.g. a Python array, is kept alive
+     * by the steps that refer to that data */
+    void KeepAlive(std::shared_ptr<void> owner);
+
 private:
     int m_Verbosity = 0;
     int m_WriterRank; // my rank in the writers' comm
@@ -59,10 +143,27 @@ private:
     bool m_InsideStep = false;
     bool m_ResetVariables = false; // used when PerformPuts is being used
 
+    /** if true, BeginStep only waits for readers to have begun the last
+     * published step, so they can consume it while the next one is being
+     * produced. The application must keep that step's data valid. Readers
+     * then have to be opened on their own IO, see InlineReader. */
+    bool m_Pipelined = false;
+
+    std::shared_ptr<InlineChannel> m_Channel =
+        std::make_shared<InlineChannel>();
+
+    /** owners of the data put since the blocks were last reset */
+    std::vector<std::shared_ptr<void>> m_Owners;
+
     void Init() final;
     void InitParameters() final;
     void InitTransports() final;
-    const InlineReader *GetReader() const;
+
+    /** attaches the readers opened on m_IO before this writer */
+    void AttachReaders();
+
+    /** snapshot of the blocks put so far, made visible to the readers */
+    void PublishStep();
 
 #define declare_type(T)                                                        \
     void DoPutSync(Variable<T> &, const T *) final;                            \
@@ -27,17 +27,31 @@ MhsReader::MhsReader(IO &io, const std::string &name, const Mode mode,
     m_SiriusCompressor = std::make_shared<compress::CompressSirius>(params);
     io.SetEngine("");
     m_SubIOs.emplace_back(&io);
-    m_SubEngines.emplace_back(&io.Open(m_Name + ".tier0", adios2::Mode::Read));
+    m_SubEngines.emplace_back(&io.Open(TierName(0), adios2::Mode::Read));
 
     for (int i = 1; i < m_Tiers; ++i)
     {
         m_SubIOs.emplace_back(
             &io.m_ADIOS.DeclareIO("SubIO" + std::to_string(i)));
-        m_SubEngines.emplace_back(&m_SubIOs.back()->Open(
-            m_Name + ".tier" + std::to_string(i), adios2::Mode::Read));
+        m_SubEngines.emplace_back(
+            &m_SubIOs.back()->Open(TierName(i), adios2::Mode::Read));
     }
 }
 
+std::string MhsReader::TierName(const int tier) const
+{
+    // same naming as MhsWriter, Tier<i>.Path moves a tier to another directory
+    std::string tierName = m_Name + ".tier" + std::to_string(tier);
+    auto itPath =
+        m_IO.m_Parameters.find("Tier" + std::to_string(tier) + ".Path");
+    if (itPath != m_IO.m_Parameters.end() && !itPath->second.empty())
+    {
+        tierName = itPath->second + PathSeparator +
+                   tierName.substr(tierName.find_last_of("/\\") + 1);
+    }
+    return tierName;
+}
+
 MhsReader::~MhsReader()
 {
     for (int i = 1; i < m_Tiers; ++i)
@@ -40,6 +40,8 @@ private:
     std::shared_ptr<compress::CompressSirius> m_SiriusCompressor;
     int m_Tiers;
 
+    std::string TierName(const int tier) const;
+
 #define declare_type(T)                                                        \
     void DoGetSync(Variable<T> &, T *) final;                                  \
     void DoGetDeferred(Variable<T> &, T *) final;
@@ -12,6 +12,8 @@
 #include "adios2/helper/adiosFunctions.h"
 #include "adios2/operator/compress/CompressSirius.h"
 
+#include <sstream>
+
 namespace adios2
 {
 namespace core
@@ -24,6 +26,7 @@ MhsWriter::MhsWriter(IO &io, const std::string &name, const Mode mode,
 : Engine("MhsWriter", io, name, mode, std::move(comm))
 {
     helper::GetParameter(io.m_Parameters, "Tiers", m_Tiers);
+    helper::GetParameter(io.m_Parameters, "AsyncTiers", m_AsyncTiers);
     for (const auto &transportParams : io.m_TransportsParameters)
     {
         auto itVar = transportParams.find("variable");
@@ -37,11 +40,44 @@ MhsWriter::MhsWriter(IO &io, const std::string &name, const Mode mode,
             continue;
         }
 
-        if (itTransport->second == "sirius")
+        if (itTransport->second == "route")
+        {
+            // io.AddTransport("route", {{"variable", "v"}, {"tiers", "0,2"}})
+            auto itTiers = transportParams.find("tiers");
+            if (itTiers == transportParams.end())
+            {
+                helper::Throw<std::invalid_argument>(
+                    "Engine", "MhsWriter", "MhsWriter",
+                    "route of variable " + itVar->second +
+                        " requires a tiers parameter");
+            }
+            std::vector<size_t> &tiers = m_VarTiers[itVar->second];
+            std::istringstream tierList(itTiers->second);
+            std::string tier;
+            while (std::getline(tierList, tier, ','))
+            {
+                tiers.push_back(helper::StringTo<size_t>(
+                    tier, "in tiers of route for variable " + itVar->second));
+                if (tiers.back() >= static_cast<size_t>(m_Tiers))
+                {
+                    helper::Throw<std::invalid_argument>(
+                        "Engine", "MhsWriter", "MhsWriter",
+                        "route of variable " + itVar->second +
+                            " refers to tier " + tier + " but Tiers is " +
+                            std::to_string(m_Tiers));
+                }
+            }
+        }
+        else if (itTransport->second == "sirius")
         {
-            m_TransportMap.emplace(
-                itVar->second,
-                std::make_shared<compress::CompressSirius>(io.m_Parameters));
+            std::vector<std::shared_ptr<Operator>> &ops =
+                m_TransportMap[itVar->second];
+            ops.clear();
+            for (int i = 0; i < m_Tiers; ++i)
+            {
+                ops.push_back(std::make_shared<compress::CompressSirius>(
+                    io.m_Parameters));
+            }
         }
         else
         {
@@ -53,13 +89,60 @@ MhsWriter::MhsWriter(IO &io, const std::string &name, const Mode mode,
     {
         m_SubIOs.emplace_back(
             &io.m_ADIOS.DeclareIO("SubIO" + std::to_string(i)));
-        m_SubEngines.emplace_back(&m_SubIOs.back()->Open(
-            m_Name + ".tier" + std::to_string(i), adios2::Mode::Write));
+
+        // Tier<i>.Engine, Tier<i>.Path, any other Tier<i>.<key> goes to the
+        // tier's engine, e.g. Tier1.Engine=BP5, Tier1.AsyncWrite=true
+        const std::string prefix = "Tier" + std::to_string(i) + ".";
+        std::string path;
+        for (const auto &param : io.m_Parameters)
+        {
+            if (param.first.compare(0, prefix.size(), prefix) != 0)
+            {
+                continue;
+            }
+            const std::string key = param.first.substr(prefix.size());
+            if (key == "Engine")
+            {
+                m_SubIOs.back()->SetEngine(param.second);
+            }
+            else if (key == "Path")
+            {
+                path = param.second;
+            }
+            else
+            {
+                m_SubIOs.back()->SetParameter(key, param.second);
+            }
+        }
+
+        std::string tierName = m_Name + ".tier" + std::to_string(i);
+        if (!path.empty())
+        {
+            tierName = path + PathSeparator +
+                       tierName.substr(tierName.find_last_of("/\\") + 1);
+        }
+        m_SubEngines.emplace_back(
+            &m_SubIOs.back()->Open(tierName, adios2::Mode::Write));
+    }
+    m_TierPuts.resize(m_Tiers);
+
+    if (m_AsyncTiers && m_Tiers > 1)
+    {
+        for (int i = 0; i < m_Tiers; ++i)
+        {
+            m_TierWorkers.emplace_back(new TierWorker());
+        }
+        for (size_t i = 0; i < m_TierWorkers.size(); ++i)
+        {
+            m_TierWorkers[i]->Thread =
+                std::thread(&MhsWriter::TierWorkerLoop, this, i);
+        }
     }
 }
 
 MhsWriter::~MhsWriter()
 {
+    StopTierWorkers();
     for (int i = 0; i < m_Tiers; ++i)
     {
         m_IO.m_ADIOS.RemoveIO("SubIO" + std::to_string(i));
@@ -68,6 +151,7 @@ MhsWriter::~MhsWriter()
 
 StepStatus MhsWriter::BeginStep(StepMode mode, const float timeoutSeconds)
 {
+    RunTierPuts();
     for (auto &e : m_SubEngines)
     {
         e->BeginStep(mode, timeoutSeconds);
@@ -79,14 +163,18 @@ size_t MhsWriter::CurrentStep() const { return m_SubEngines[0]->CurrentStep(); }
 
 void MhsWriter::PerformPuts()
 {
-    for (auto &e : m_SubEngines)
+    for (size_t i = 0; i < m_SubEngines.size(); ++i)
     {
-        e->PerformPuts();
+        Engine *e = m_SubEngines[i];
+        m_TierPuts[i].emplace_back([e]() { e->PerformPuts(); });
     }
+    RunTierPuts();
 }
 
 void MhsWriter::EndStep()
 {
+    // sub-engine steps may be collective, they stay on this thread
+    RunTierPuts();
     for (auto &e : m_SubEngines)
     {
         e->EndStep();
@@ -95,6 +183,7 @@ void MhsWriter::EndStep()
 
 void MhsWriter::Flush(const int transportIndex)
 {
+    RunTierPuts();
     for (auto &e : m_SubEngines)
     {
         e->Flush(transportIndex);
@@ -102,6 +191,134 @@ void MhsWriter::Flush(const int transportIndex)
 }
 
 // PRIVATE
+void MhsWriter::RunTier(const size_t tier)
+{
+    for (auto &put : m_TierPuts[tier])
+    {
+        put();
+    }
+    m_TierPuts[tier].clear();
+}
+
+void MhsWriter::TierWorkerLoop(const size_t tier)
+{
+    TierWorker &worker = *m_TierWorkers[tier];
+    std::unique_lock<std::mutex> lock(worker.Mutex);
+    while (true)
+    {
+        worker.Wake.wait(lock,
+                         [&worker]() { return worker.Busy || worker.Stop; });
+        if (!worker.Busy)
+        {
+            return;
+        }
+        lock.unlock();
+        std::exception_ptr error;
+        try
+        {
+            RunTier(tier);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        lock.lock();
+        worker.Error = error;
+        worker.Busy = false;
+        worker.Wake.notify_all();
+    }
+}
+
+void MhsWriter::StopTierWorkers()
+{
+    for (auto &worker : m_TierWorkers)
+    {
+        {
+            std::lock_guard<std::mutex> lock(worker->Mutex);
+            worker->Stop = true;
+        }
+        worker->Wake.notify_all();
+        if (worker->Thread.joinable())
+        {
+            worker->Thread.join();
+        }
+    }
+    m_TierWorkers.clear();
+}
+
+void MhsWriter::RunTierPuts()
+{
+    std::vector<size_t> busyTiers;
+    for (size_t i = 0; i < m_TierPuts.size(); ++i)
+    {
+        if (!m_TierPuts[i].empty())
+        {
+            busyTiers.push_back(i);
+        }
+    }
+    if (busyTiers.empty())
+    {
+        return;
+    }
+
+    std::exception_ptr error;
+    if (m_TierWorkers.empty() || busyTiers.size() == 1)
+    {
+        try
+        {
+            for (const size_t i : busyTiers)
+            {
+                RunTier(i);
+            }
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+    }
+    else
+    {
+        // each tier touches only its own sub-IO and sub-engine, the last
+        // busy tier runs on this thread
+        for (size_t k = 0; k + 1 < busyTiers.size(); ++k)
+        {
+            TierWorker &worker = *m_TierWorkers[busyTiers[k]];
+            {
+                std::lock_guard<std::mutex> lock(worker.Mutex);
+                worker.Busy = true;
+            }
+            worker.Wake.notify_all();
+        }
+        try
+        {
+            RunTier(busyTiers.back());
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        for (size_t k = 0; k + 1 < busyTiers.size(); ++k)
+        {
+            TierWorker &worker = *m_TierWorkers[busyTiers[k]];
+            std::unique_lock<std::mutex> lock(worker.Mutex);
+            worker.Wake.wait(lock, [&worker]() { return !worker.Busy; });
+            if (!error)
+            {
+                error = worker.Error;
+            }
+            worker.Error = nullptr;
+        }
+    }
+
+    if (error)
+    {
+        for (auto &puts : m_TierPuts)
+        {
+            puts.clear();
+        }
+        std::rethrow_exception(error);
+    }
+}
 
 #define declare_type(T)                                                        \
     void MhsWriter::DoPutSync(Variable<T> &variable, const T *data)            \
@@ -117,6 +334,8 @@ ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 
 void MhsWriter::DoClose(const int transportIndex)
 {
+    RunTierPuts();
+    StopTierWorkers();
     for (auto &e : m_SubEngines)
     {
         e->Close();
@@ -13,6 +13,13 @@
 
 #include "adios2/core/Engine.h"
 
+#include <condition_variable>
+#include <exception> // std::exception_ptr
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 namespace adios2
 {
 namespace core
@@ -38,11 +45,50 @@ public:
 private:
     std::vector<IO *> m_SubIOs;
     std::vector<Engine *> m_SubEngines;
-    std::unordered_map<std::string, std::shared_ptr<Operator>> m_TransportMap;
+    /** operators of a variable, one instance per tier */
+    std::unordered_map<std::string, std::vector<std::shared_ptr<Operator>>>
+        m_TransportMap;
     int m_Tiers = 1;
 
+    /** run the puts of different tiers concurrently, one thread per tier */
+    bool m_AsyncTiers = true;
+
+    /** a persistent thread running the queued puts of one tier */
+    struct TierWorker
+    {
+        std::thread Thread;
+        std::mutex Mutex;
+        std::condition_variable Wake;
+        /** the tier's queue was handed to the thread and is not done */
+        bool Busy = false;
+        bool Stop = false;
+        std::exception_ptr Error;
+    };
+
+    /** one per tier if m_AsyncTiers and there is more than one tier */
+    std::vector<std::unique_ptr<TierWorker>> m_TierWorkers;
+
+    /** tiers a variable is routed to, default is tier 0 only */
+    std::unordered_map<std::string, std::vector<size_t>> m_VarTiers;
+
+    /** puts queued per tier until PerformPuts/EndStep */
+    std::vector<std::vector<std::function<void()>>> m_TierPuts;
+
     void PutSubEngine(bool finalPut = false);
 
+    /** executes and clears m_TierPuts, concurrently across tiers if
+     * m_AsyncTiers, returns when all tiers are done. If a put fails the
+     * puts still queued on any tier are dropped and the first error is
+     * rethrown once every tier has stopped. */
+    void RunTierPuts();
+
+    /** executes and clears the queued puts of one tier */
+    void RunTier(const size_t tier);
+
+    void TierWorkerLoop(const size_t tier);
+
+    void StopTierWorkers();
+
 #define declare_type(T)                                                        \
     void DoPutSync(Variable<T> &, const T *) final;                            \
     void DoPutDeferred(Variable<T> &, const T *) final;
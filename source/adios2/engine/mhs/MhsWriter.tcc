@@ -24,64 +24,80 @@ template <>
 void MhsWriter::PutDeferredCommon<std::string>(Variable<std::string> &variable,
                                                const std::string *data)
 {
-    auto var = m_SubIOs[0]->InquireVariable<std::string>(variable.m_Name);
-    if (!var)
-    {
-        var = &m_SubIOs[0]->DefineVariable<std::string>(variable.m_Name,
-                                                        {LocalValueDim});
-    }
-    m_SubEngines[0]->Put(variable, data, Mode::Sync);
+    IO *io = m_SubIOs[0];
+    Engine *engine = m_SubEngines[0];
+    m_TierPuts[0].emplace_back([io, engine, &variable, data]() {
+        auto var = io->InquireVariable<std::string>(variable.m_Name);
+        if (!var)
+        {
+            var = &io->DefineVariable<std::string>(variable.m_Name,
+                                                   {LocalValueDim});
+        }
+        engine->Put(variable, data, Mode::Sync);
+    });
 }
 
 template <class T>
 void MhsWriter::PutSyncCommon(Variable<T> &variable, const T *data)
 {
     PutDeferredCommon(variable, data);
-    PerformPuts();
+    RunTierPuts();
 }
 
 template <class T>
 void MhsWriter::PutDeferredCommon(Variable<T> &variable, const T *data)
 {
     bool putToAll = false;
+    std::vector<std::shared_ptr<Operator>> ops;
     auto itVar = m_TransportMap.find(variable.m_Name);
     if (itVar != m_TransportMap.end())
     {
-        if (itVar->second->m_TypeString == "sirius")
+        ops = itVar->second;
+        if (ops[0]->m_TypeString == "sirius")
         {
             putToAll = true;
         }
     }
 
-    auto var0 = m_SubIOs[0]->InquireVariable<T>(variable.m_Name);
-    if (!var0)
-    {
-        var0 =
-            &m_SubIOs[0]->DefineVariable<T>(variable.m_Name, variable.m_Shape);
-        itVar = m_TransportMap.find(variable.m_Name);
-        if (itVar != m_TransportMap.end())
+    // the selection may change before the queued put runs
+    const std::string name = variable.m_Name;
+    const Dims shape = variable.m_Shape;
+    const Box<Dims> selection = {variable.m_Start, variable.m_Count};
+    auto lf_PutTier = [this, name, shape, selection, ops, data](size_t i) {
+        auto var = m_SubIOs[i]->InquireVariable<T>(name);
+        if (!var)
         {
-            var0->AddOperation(itVar->second);
+            var = &m_SubIOs[i]->DefineVariable<T>(name, shape);
+            if (!ops.empty())
+            {
+                var->AddOperation(ops[i]);
+            }
         }
-    }
-
-    var0->SetSelection({variable.m_Start, variable.m_Count});
-    m_SubEngines[0]->Put(*var0, data, Mode::Sync);
+        var->SetSelection(selection);
+        m_SubEngines[i]->Put(*var, data, Mode::Sync);
+    };
 
     if (putToAll)
     {
-        for (size_t i = 1; i < m_SubEngines.size(); ++i)
+        // sirius splits the data across tiers in tier order and keeps that
+        // state in static members, the tiers' instances run in sequence
+        RunTierPuts();
+        for (size_t i = 0; i < m_SubEngines.size(); ++i)
         {
-            auto var = m_SubIOs[i]->InquireVariable<T>(variable.m_Name);
-            if (!var)
-            {
-                var = &m_SubIOs[i]->DefineVariable<T>(variable.m_Name,
-                                                      variable.m_Shape);
-                var->AddOperation(itVar->second);
-            }
-            var->SetSelection({variable.m_Start, variable.m_Count});
-            m_SubEngines[i]->Put(*var, data, Mode::Sync);
+            lf_PutTier(i);
         }
+        return;
+    }
+
+    auto itTiers = m_VarTiers.find(name);
+    if (itTiers == m_VarTiers.end())
+    {
+        m_TierPuts[0].emplace_back([lf_PutTier]() { lf_PutTier(0); });
+        return;
+    }
+    for (const size_t i : itTiers->second)
+    {
+        m_TierPuts[i].emplace_back([lf_PutTier, i]() { lf_PutTier(i); });
     }
 }
 
@@ -273,6 +273,7 @@ SstReader::SstReader(IO &io, const std::string &name, const Mode mode,
 
 SstReader::~SstReader()
 {
+    WaitForAsyncGets();
     if (m_BP5Deserializer)
         delete m_BP5Deserializer;
     SstStreamDestroy(m_Input);
@@ -283,6 +284,7 @@ StepStatus SstReader::BeginStep(StepMode Mode, const float timeout_sec)
     PERFSTUBS_SCOPED_TIMER_FUNC();
 
     SstStatusValue result;
+    WaitForAsyncGets();
     if (m_BetweenStepPairs)
     {
         helper::Throw<std::logic_error>("Engine", "SstReader", "BeginStep",
@@ -453,6 +455,7 @@ void SstReader::EndStep()
     }
     m_BetweenStepPairs = false;
     PERFSTUBS_SCOPED_TIMER_FUNC();
+    WaitForAsyncGets();
     if (m_ReaderSelectionsLocked && !m_DefinitionsNotified)
     {
         SstReaderDefinitionLock(m_Input, SstCurrentStep(m_Input));
@@ -641,6 +644,12 @@ ADIOS2_FOREACH_STDTYPE_1ARG(declare_gets)
 void SstReader::BP5PerformGets()
 {
     auto ReadRequests = m_BP5Deserializer->GenerateReadRequests();
+    BP5CompleteReads(ReadRequests, BP5IssueReads(ReadRequests));
+}
+
+std::vector<void *> SstReader::BP5IssueReads(
+    const std::vector<format::BP5Deserializer::ReadRequest> &ReadRequests)
+{
     std::vector<void *> sstReadHandlers;
     for (const auto &Req : ReadRequests)
     {
@@ -654,12 +663,19 @@ void SstReader::BP5PerformGets()
                                        Req.DestinationAddr, dp_info);
         sstReadHandlers.push_back(ret);
     }
+    return sstReadHandlers;
+}
+
+void SstReader::BP5CompleteReads(
+    std::vector<format::BP5Deserializer::ReadRequest> &ReadRequests,
+    const std::vector<void *> &sstReadHandlers)
+{
     for (const auto &i : sstReadHandlers)
     {
         if (SstWaitForCompletion(m_Input, i) != SstSuccess)
         {
             helper::Throw<std::runtime_error>(
-                "Engine", "SstReader", "BP5PerformGets",
+                "Engine", "SstReader", "BP5CompleteReads",
                 "Writer failed before returning data");
         }
     }
@@ -669,6 +685,7 @@ void SstReader::BP5PerformGets()
 
 void SstReader::PerformGets()
 {
+    WaitForAsyncGets();
     if (m_WriterMarshalMethod == SstMarshalFFS)
     {
         SstFFSPerformGets(m_Input);
@@ -747,7 +764,30 @@ void SstReader::PerformGets()
     }
 }
 
-void SstReader::DoClose(const int transportIndex) { SstReaderClose(m_Input); }
+std::future<void> SstReader::PerformGetsAsync()
+{
+    if (m_WriterMarshalMethod != SstMarshalBP5)
+    {
+        return Engine::PerformGetsAsync();
+    }
+    WaitForAsyncGets();
+    // the remote reads are issued here and progress on their own, waiting for
+    // them and placing the data moves to the background
+    auto ReadRequests =
+        std::make_shared<std::vector<format::BP5Deserializer::ReadRequest>>(
+            m_BP5Deserializer->GenerateReadRequests());
+    auto sstReadHandlers =
+        std::make_shared<std::vector<void *>>(BP5IssueReads(*ReadRequests));
+    return LaunchAsyncGets([this, ReadRequests, sstReadHandlers]() {
+        BP5CompleteReads(*ReadRequests, *sstReadHandlers);
+    });
+}
+
+void SstReader::DoClose(const int transportIndex)
+{
+    WaitForAsyncGets();
+    SstReaderClose(m_Input);
+}
 
 MinVarInfo *SstReader::MinBlocksInfo(const VariableBase &Var,
                                      const size_t Step) const
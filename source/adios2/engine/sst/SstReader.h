@@ -49,6 +49,9 @@ public:
     size_t CurrentStep() const final;
     void EndStep();
     void PerformGets();
+    /** with BP5 marshaling, waiting for the remote reads and placing the
+     * data happens on a background thread */
+    std::future<void> PerformGetsAsync() final;
     void Flush(const int transportIndex = -1) final;
     MinVarInfo *MinBlocksInfo(const VariableBase &, const size_t Step) const;
 
@@ -66,6 +69,11 @@ private:
     template <class T>
     void SstBPPerformGets();
     void BP5PerformGets();
+    std::vector<void *> BP5IssueReads(
+        const std::vector<format::BP5Deserializer::ReadRequest> &ReadRequests);
+    void BP5CompleteReads(
+        std::vector<format::BP5Deserializer::ReadRequest> &ReadRequests,
+        const std::vector<void *> &sstReadHandlers);
     void Init();
     SstStream m_Input;
     SstMarshalMethod m_WriterMarshalMethod;
@@ -11,7 +11,17 @@
 #include "adiosMemory.h"
 
 #include <algorithm>
+#include <cstring>  // std::memcpy
 #include <stddef.h> // max_align_t
+#include <thread>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <nmmintrin.h>
+#define ADIOS2_CRC32C_SSE42
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define ADIOS2_CRC32C_ARMV8
+#endif
 
 #include "adios2/helper/adiosType.h"
 
@@ -311,6 +321,205 @@ uint64_t PaddingToAlignOffset(uint64_t offset, uint64_t alignment_size)
     return padSize;
 }
 
+namespace
+{
+
+// reflected Castagnoli polynomial
+constexpr uint32_t Crc32cPoly = 0x82F63B78;
+
+struct Crc32cTables
+{
+    uint32_t T[8][256];
+
+    Crc32cTables() noexcept
+    {
+        for (uint32_t n = 0; n < 256; ++n)
+        {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k)
+            {
+                c = (c & 1) ? (c >> 1) ^ Crc32cPoly : (c >> 1);
+            }
+            T[0][n] = c;
+        }
+        for (uint32_t n = 0; n < 256; ++n)
+        {
+            for (int k = 1; k < 8; ++k)
+            {
+                T[k][n] = (T[k - 1][n] >> 8) ^ T[0][T[k - 1][n] & 0xff];
+            }
+        }
+    }
+};
+
+const Crc32cTables &GetCrc32cTables() noexcept
+{
+    static const Crc32cTables tables;
+    return tables;
+}
+
+// slicing-by-8 software fallback, words are taken in memory order
+uint32_t Crc32cWordSW(const Crc32cTables &t, uint32_t crc,
+                      uint64_t word) noexcept
+{
+    unsigned char b[8];
+    std::memcpy(b, &word, 8);
+    const uint32_t lo = crc ^ (uint32_t(b[0]) | uint32_t(b[1]) << 8 |
+                               uint32_t(b[2]) << 16 | uint32_t(b[3]) << 24);
+    return t.T[7][lo & 0xff] ^ t.T[6][(lo >> 8) & 0xff] ^
+           t.T[5][(lo >> 16) & 0xff] ^ t.T[4][lo >> 24] ^ t.T[3][b[4]] ^
+           t.T[2][b[5]] ^ t.T[1][b[6]] ^ t.T[0][b[7]];
+}
+
+uint32_t Crc32cSW(uint32_t crc, const unsigned char *src, unsigned char *dest,
+                  size_t size) noexcept
+{
+    const Crc32cTables &t = GetCrc32cTables();
+    for (; size >= 8; size -= 8, src += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, src, 8);
+        if (dest)
+        {
+            std::memcpy(dest, &word, 8);
+            dest += 8;
+        }
+        crc = Crc32cWordSW(t, crc, word);
+    }
+    for (; size; --size, ++src)
+    {
+        if (dest)
+        {
+            *dest++ = *src;
+        }
+        crc = t.T[0][(crc ^ *src) & 0xff] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#if defined(ADIOS2_CRC32C_SSE42)
+__attribute__((target("sse4.2"))) uint32_t
+Crc32cHW(uint32_t crc, const unsigned char *src, unsigned char *dest,
+         size_t size) noexcept
+{
+    uint64_t crc64 = crc;
+    for (; size >= 8; size -= 8, src += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, src, 8);
+        if (dest)
+        {
+            std::memcpy(dest, &word, 8);
+            dest += 8;
+        }
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+    crc = static_cast<uint32_t>(crc64);
+    for (; size; --size, ++src)
+    {
+        if (dest)
+        {
+            *dest++ = *src;
+        }
+        crc = _mm_crc32_u8(crc, *src);
+    }
+    return crc;
+}
+
+bool HaveCrc32cHW() noexcept
+{
+    static const bool have = __builtin_cpu_supports("sse4.2");
+    return have;
+}
+#elif defined(ADIOS2_CRC32C_ARMV8)
+uint32_t Crc32cHW(uint32_t crc, const unsigned char *src, unsigned char *dest,
+                  size_t size) noexcept
+{
+    for (; size >= 8; size -= 8, src += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, src, 8);
+        if (dest)
+        {
+            std::memcpy(dest, &word, 8);
+            dest += 8;
+        }
+        crc = __crc32cd(crc, word);
+    }
+    for (; size; --size, ++src)
+    {
+        if (dest)
+        {
+            *dest++ = *src;
+        }
+        crc = __crc32cb(crc, *src);
+    }
+    return crc;
+}
+
+bool HaveCrc32cHW() noexcept { return true; }
+#endif
+
+uint32_t Crc32cCopy(uint32_t crc, const void *src, void *dest,
+                    size_t size) noexcept
+{
+    const unsigned char *s = static_cast<const unsigned char *>(src);
+    unsigned char *d = static_cast<unsigned char *>(dest);
+    crc = ~crc;
+#if defined(ADIOS2_CRC32C_SSE42) || defined(ADIOS2_CRC32C_ARMV8)
+    if (HaveCrc32cHW())
+    {
+        return ~Crc32cHW(crc, s, d, size);
+    }
+#endif
+    return ~Crc32cSW(crc, s, d, size);
+}
+
+} // end anonymous namespace
+
+uint32_t Crc32c(const void *data, const size_t size,
+                const uint32_t crc) noexcept
+{
+    return Crc32cCopy(crc, data, nullptr, size);
+}
+
+uint32_t CopyWithCrc32c(void *dest, const void *src, const size_t size,
+                        const uint32_t crc) noexcept
+{
+    return Crc32cCopy(crc, src, dest, size);
+}
+
+void CopyMemoryThreads(void *dest, const void *src, const size_t size,
+                       const unsigned int threads) noexcept
+{
+    const size_t parts = std::max<size_t>(
+        1, std::min<size_t>(threads, size / MinThreadCopySize));
+    if (parts == 1)
+    {
+        std::memcpy(dest, src, size);
+        return;
+    }
+
+    const size_t stride = size / parts; // the last part takes the remainder
+    char *d = reinterpret_cast<char *>(dest);
+    const char *s = reinterpret_cast<const char *>(src);
+
+    std::vector<std::thread> copyThreads;
+    copyThreads.reserve(parts - 1);
+    for (size_t t = 0; t < parts - 1; ++t)
+    {
+        copyThreads.emplace_back(std::memcpy, d + t * stride, s + t * stride,
+                                 stride);
+    }
+    const size_t lastStart = (parts - 1) * stride;
+    std::memcpy(d + lastStart, s + lastStart, size - lastStart);
+
+    for (auto &copyThread : copyThreads)
+    {
+        copyThread.join();
+    }
+}
+
 #ifdef ADIOS2_HAVE_CUDA
 void MemcpyGPUToBuffer(void *dst, const char *GPUbuffer, size_t byteCount)
 {
@@ -91,6 +91,21 @@ void CopyToBufferThreads(std::vector<char> &buffer, size_t &position,
                          const T *source, const size_t elements = 1,
                          const unsigned int threads = 1) noexcept;
 
+/**
+ * memcpy split over threads, the calling thread copies the last part.
+ * Fewer threads are used if a part would be smaller than
+ * MinThreadCopySize, so small copies stay on the calling thread.
+ * @param dest destination
+ * @param src source
+ * @param size number of bytes
+ * @param threads maximum number of threads sharing the copy
+ */
+void CopyMemoryThreads(void *dest, const void *src, const size_t size,
+                       const unsigned int threads) noexcept;
+
+/** smallest part of a copy given to a thread by CopyMemoryThreads */
+constexpr size_t MinThreadCopySize = 1024 * 1024;
+
 template <class T>
 void ReverseCopyFromBuffer(const std::vector<char> &buffer, size_t &position,
                            T *destination, const size_t elements = 1) noexcept;
@@ -275,6 +290,25 @@ size_t PaddingToAlignPointer(const void *ptr);
  * the size alignment_size */
 uint64_t PaddingToAlignOffset(uint64_t offset, uint64_t alignment_size);
 
+/**
+ * CRC-32C (Castagnoli) of a memory block, uses the SSE4.2 / ARMv8 crc32
+ * instructions when the CPU has them.
+ * @param data block to checksum
+ * @param size number of bytes in data
+ * @param crc checksum of the preceding bytes when checksumming in pieces
+ * @return checksum of the bytes seen so far
+ */
+uint32_t Crc32c(const void *data, const size_t size,
+                const uint32_t crc = 0) noexcept;
+
+/**
+ * memcpy that computes the CRC-32C of the copied bytes in the same pass,
+ * so the source is only streamed through the cache once.
+ * @return checksum as Crc32c(src, size, crc)
+ */
+uint32_t CopyWithCrc32c(void *dest, const void *src, const size_t size,
+                        const uint32_t crc = 0) noexcept;
+
 } // end namespace helper
 } // end namespace adios2
 
@@ -10,6 +10,7 @@
 #include "MPIShmChain.h"
 
 #include "adios2/helper/adiosMemory.h" // PaddingToAlignOffset
+#include "adios2/toolkit/shm/Futex.h"
 
 #include <iostream>
 
@@ -215,7 +216,8 @@ void MPIShmChain::HandshakeLinks_Complete(HandshakeStruct &hs)
 }
 
 void MPIShmChain::CreateShm(size_t blocksize, const size_t maxsegmentsize,
-                            const size_t alignment_size)
+                            const size_t alignment_size,
+                            const size_t numBuffers)
 {
     if (!m_Comm.IsMPI())
     {
@@ -223,23 +225,40 @@ void MPIShmChain::CreateShm(size_t blocksize, const size_t maxsegmentsize,
             "Toolkit", "aggregator::mpi::MPIShmChain", "CreateShm",
             "called with a non-MPI communicator");
     }
+    if (numBuffers < 1 || numBuffers > MaxShmBuffers)
+    {
+        helper::Throw<std::invalid_argument>(
+            "Toolkit", "aggregator::mpi::MPIShmChain", "CreateShm",
+            "the number of shared memory buffers must be between 1 and " +
+                std::to_string(MaxShmBuffers) + ", got " +
+                std::to_string(numBuffers));
+    }
     char *ptr;
     size_t structsize = sizeof(ShmSegment);
     structsize += helper::PaddingToAlignOffset(structsize, alignment_size);
+    if (maxsegmentsize < structsize + 2 * numBuffers * alignment_size)
+    {
+        helper::Throw<std::invalid_argument>(
+            "Toolkit", "aggregator::mpi::MPIShmChain", "CreateShm",
+            "the shared memory segment size " +
+                std::to_string(maxsegmentsize) + " is too small for " +
+                std::to_string(numBuffers) + " buffers");
+    }
     if (!m_Rank)
     {
         blocksize += helper::PaddingToAlignOffset(blocksize, alignment_size);
-        size_t totalsize = structsize + 2 * blocksize;
+        size_t totalsize = structsize + numBuffers * blocksize;
         if (totalsize > maxsegmentsize)
         {
             // roll back and calculate sizes from maxsegmentsize
             totalsize = maxsegmentsize - alignment_size + 1;
             totalsize +=
                 helper::PaddingToAlignOffset(totalsize, alignment_size);
-            blocksize = (totalsize - structsize) / 2 - alignment_size + 1;
+            blocksize =
+                (totalsize - structsize) / numBuffers - alignment_size + 1;
             blocksize +=
                 helper::PaddingToAlignOffset(blocksize, alignment_size);
-            totalsize = structsize + 2 * blocksize;
+            totalsize = structsize + numBuffers * blocksize;
         }
         m_Win = m_Comm.Win_allocate_shared(totalsize, 1, &ptr);
     }
@@ -249,25 +268,32 @@ void MPIShmChain::CreateShm(size_t blocksize, const size_t maxsegmentsize,
         size_t shmsize;
         int disp_unit;
         m_Comm.Win_shared_query(m_Win, 0, &shmsize, &disp_unit, &ptr);
-        blocksize = (shmsize - structsize) / 2;
+        blocksize = (shmsize - structsize) / numBuffers;
     }
     m_Shm = reinterpret_cast<ShmSegment *>(ptr);
-    m_ShmBufA = ptr + structsize;
-    m_ShmBufB = m_ShmBufA + blocksize;
+    m_ShmBufs.resize(numBuffers);
+    for (size_t i = 0; i < numBuffers; ++i)
+    {
+        m_ShmBufs[i] = ptr + structsize + i * blocksize;
+    }
+    m_ProducerBuffer = 0;
+    m_ConsumerBuffer = 0;
 
     if (!m_Rank)
     {
-        m_Shm->producerBuffer = LastBufferUsed::None;
-        m_Shm->consumerBuffer = LastBufferUsed::None;
-        m_Shm->NumBuffersFull = 0;
-        m_Shm->sdbA.buf = nullptr;
-        m_Shm->sdbA.max_size = blocksize;
-        m_Shm->sdbB.buf = nullptr;
-        m_Shm->sdbB.max_size = blocksize;
+        m_Shm->NumBuffersFull.store(0);
+        m_Shm->NumBuffers = static_cast<uint32_t>(numBuffers);
+        m_Shm->ProducerBuffer.store(0);
+        m_Shm->ConsumerBuffer = 0;
+        for (size_t i = 0; i < numBuffers; ++i)
+        {
+            m_Shm->sdb[i].buf = nullptr;
+            m_Shm->sdb[i].max_size = blocksize;
+        }
     }
     /*std::cout << "Rank " << m_Rank << " shm = " << ptr
-              << " bufA = " << static_cast<void *>(m_Shm->bufA)
-              << " bufB = " << static_cast<void *>(m_Shm->bufB) << std::endl;*/
+              << " buf0 = " << static_cast<void *>(m_ShmBufs[0])
+              << std::endl;*/
 }
 
 void MPIShmChain::DestroyShm() { m_Comm.Win_free(m_Win); }
@@ -276,151 +302,79 @@ void MPIShmChain::DestroyShm() { m_Comm.Win_free(m_Win); }
    The buffering strategy is the following.
    Assumptions: 1. Only one Producer (and one Consumer) is active at a time.
 
-   The first Producer fills buffer A first then B and then is always
-   alternating, blocking when Consumer is behind (NumBuffersFull == 2).
-   The next Producer will continue with the alternating pattern where the
-   previous Producer has finished.
+   The buffers form a ring. The Producers fill them in order, blocking when
+   the Consumer is behind (NumBuffersFull == NumBuffers). The next Producer
+   continues with the buffer after the last one filled by the previous
+   Producer, which it finds in m_Shm->ProducerBuffer.
 
-   The Consumer is blocked until there is at least one buffer available.
-   It takes buffer A at the first call, then it alternates between the two
-   buffers.
+   The Consumer is blocked until there is at least one buffer filled. It
+   consumes the buffers in the same order.
 
-   C++ atomic locks in Shm for IPC locking:
-   - lockSegment is used to modify the m_Shm variables exclusively (short time),
-   - lockA and lockB are used to give long term exclusive access to one buffer
-   to be filled or consumed.
+   Since there is only a single Producer and a single Consumer at any time,
+   a buffer is claimed by reading the ring position, no locking is needed.
+   NumBuffersFull is the only word changed by both. A filled buffer is
+   published by incrementing it after the data is written, and released by
+   decrementing it after the data is consumed. Both parties block on it with
+   a futex wait, and wake up the other party after changing it, so a handoff
+   does not wait for a polling interval to pass.
 
-   The sleeping phases, to wait on the other party to catch up, are outside of
-   the locking code areas.
+   Note: the m_Shm->sdb[i].buf pointers must be set on the local process
+   every time, even tough it is stored on the shared memory segment, because
+   the address of the segment is different on every process. Failing to set
+   on the local process causes this pointer pointing to an invalid address
+   (set on another process).
 
-   Note: the m_Shm->sdbX.buf pointers must be set on the local process every
-   time, even tough it is stored on the shared memory segment, because the
-   address of the segment is different on every process. Failing to set on the
-   local process causes this pointer pointing to an invalid address (set on
-   another process).
-
-   Note: the sdbA and sdbB structs are stored on the shared memory segment
-   because they contain 'actual_size' which is set on the Producer and used by
-   the Consumer.
+   Note: the sdb structs are stored on the shared memory segment because
+   they contain 'actual_size' which is set on the Producer and used by the
+   Consumer.
 
 */
 
 MPIShmChain::ShmDataBuffer *MPIShmChain::LockProducerBuffer()
 {
-    MPIShmChain::ShmDataBuffer *sdb = nullptr;
-
-    // Sleep until there is a buffer available at all
-    while (m_Shm->NumBuffersFull == 2)
+    // Block until there is a buffer available at all
+    const uint32_t numBuffers = m_Shm->NumBuffers;
+    uint32_t full;
+    while ((full = m_Shm->NumBuffersFull.load()) == numBuffers)
     {
-        std::this_thread::sleep_for(std::chrono::duration<double>(0.00001));
-    }
-
-    m_Shm->lockSegment.lock();
-    if (m_Shm->producerBuffer == LastBufferUsed::A)
-
-    {
-        m_Shm->producerBuffer = LastBufferUsed::B;
-        sdb = &m_Shm->sdbB;
-        // point to shm data buffer (in local process memory)
-        sdb->buf = m_ShmBufB;
-    }
-    else // None or B
-    {
-        m_Shm->producerBuffer = LastBufferUsed::A;
-        sdb = &m_Shm->sdbA;
-        // point to shm data buffer (in local process memory)
-        sdb->buf = m_ShmBufA;
-    }
-    m_Shm->lockSegment.unlock();
-
-    // We determined we want a specific buffer
-    // Now we need to get a lock on it in case consumer is using it
-    if (m_Shm->producerBuffer == LastBufferUsed::A)
-    {
-        m_Shm->lockA.lock();
-    }
-    else
-    {
-        m_Shm->lockB.lock();
+        shm::FutexWait(m_Shm->NumBuffersFull, full);
     }
 
+    m_ProducerBuffer = m_Shm->ProducerBuffer.load();
+    MPIShmChain::ShmDataBuffer *sdb = &m_Shm->sdb[m_ProducerBuffer];
+    // point to shm data buffer (in local process memory)
+    sdb->buf = m_ShmBufs[m_ProducerBuffer];
     return sdb;
 }
 
 void MPIShmChain::UnlockProducerBuffer()
 {
-    m_Shm->lockSegment.lock();
+    m_Shm->ProducerBuffer.store((m_ProducerBuffer + 1) % m_Shm->NumBuffers);
     ++m_Shm->NumBuffersFull;
-    m_Shm->lockSegment.unlock();
-
-    if (m_Shm->producerBuffer == LastBufferUsed::A)
-    {
-        m_Shm->lockA.unlock();
-    }
-    else
-    {
-        m_Shm->lockB.unlock();
-    }
+    shm::FutexWakeAll(m_Shm->NumBuffersFull);
 }
 
 MPIShmChain::ShmDataBuffer *MPIShmChain::LockConsumerBuffer()
 {
-    MPIShmChain::ShmDataBuffer *sdb = nullptr;
-
-    // Sleep until there is at least one buffer filled
-    while (m_Shm->NumBuffersFull < 1)
-    {
-        std::this_thread::sleep_for(std::chrono::duration<double>(0.00001));
-    }
-    // At this point we know buffer A has content or going to have content
-    // when we successfully lock it
-
-    m_Shm->lockSegment.lock();
-    if (m_Shm->consumerBuffer == LastBufferUsed::A)
-
-    {
-        m_Shm->consumerBuffer = LastBufferUsed::B;
-        sdb = &m_Shm->sdbB;
-        // point to shm data buffer (in local process memory)
-        sdb->buf = m_ShmBufB;
-    }
-    else // None or B
+    // Block until there is at least one buffer filled
+    uint32_t full;
+    while ((full = m_Shm->NumBuffersFull.load()) == 0)
     {
-        m_Shm->consumerBuffer = LastBufferUsed::A;
-        sdb = &m_Shm->sdbA;
-        // point to shm data buffer (in local process memory)
-        sdb->buf = m_ShmBufA;
-    }
-    m_Shm->lockSegment.unlock();
-
-    // We determined we want a specific buffer
-    // Now we need to get a lock on it in case producer is using it
-    if (m_Shm->consumerBuffer == LastBufferUsed::A)
-    {
-        m_Shm->lockA.lock();
-    }
-    else
-    {
-        m_Shm->lockB.lock();
+        shm::FutexWait(m_Shm->NumBuffersFull, full);
     }
 
+    m_ConsumerBuffer = m_Shm->ConsumerBuffer;
+    MPIShmChain::ShmDataBuffer *sdb = &m_Shm->sdb[m_ConsumerBuffer];
+    // point to shm data buffer (in local process memory)
+    sdb->buf = m_ShmBufs[m_ConsumerBuffer];
     return sdb;
 }
 
 void MPIShmChain::UnlockConsumerBuffer()
 {
-    m_Shm->lockSegment.lock();
+    m_Shm->ConsumerBuffer = (m_ConsumerBuffer + 1) % m_Shm->NumBuffers;
     --m_Shm->NumBuffersFull;
-    m_Shm->lockSegment.unlock();
-
-    if (m_Shm->consumerBuffer == LastBufferUsed::A)
-    {
-        m_Shm->lockA.unlock();
-    }
-    else
-    {
-        m_Shm->lockB.unlock();
-    }
+    shm::FutexWakeAll(m_Shm->NumBuffersFull);
 }
 
 } // end namespace aggregator
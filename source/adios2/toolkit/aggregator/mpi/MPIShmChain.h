@@ -14,11 +14,10 @@
 
 #include "adios2/common/ADIOSConfig.h"
 #include "adios2/toolkit/aggregator/mpi/MPIAggregator.h"
-#include "adios2/toolkit/shm/Spinlock.h"
 
 #include <atomic>
-#include <chrono>
-#include <thread>
+#include <cstdint>
+#include <vector>
 
 namespace adios2
 {
@@ -26,7 +25,8 @@ namespace aggregator
 {
 
 // constexpr size_t SHM_BUF_SIZE = 4194304; // 4MB
-// we allocate 2x this size + a bit for shared memory segment
+// we allocate numBuffers x this size + a bit for shared memory segment
+constexpr size_t MaxShmBuffers = 16;
 
 /** A one- or two-layer aggregator chain for using Shared memory within a
  * compute node.
@@ -109,9 +109,9 @@ public:
     void UnlockConsumerBuffer();
     void ResetBuffers() noexcept;
 
-    // 2*blocksize+some is allocated but only up to maxsegmentsize
+    // numBuffers*blocksize+some is allocated but only up to maxsegmentsize
     void CreateShm(size_t blocksize, const size_t maxsegmentsize,
-                   const size_t alignment_size);
+                   const size_t alignment_size, const size_t numBuffers = 2);
     void DestroyShm();
 
 private:
@@ -128,32 +128,25 @@ private:
 
     helper::Comm::Win m_Win;
 
-    enum class LastBufferUsed
-    {
-        None,
-        A,
-        B
-    };
-
     struct ShmSegment
     {
-        LastBufferUsed producerBuffer;
-        LastBufferUsed consumerBuffer;
-        unsigned int NumBuffersFull;
+        // filled and not yet consumed buffers, producer and consumer
+        // block on this word
+        std::atomic<uint32_t> NumBuffersFull;
+        uint32_t NumBuffers;
+        // next buffer to fill, passed on from producer to producer
+        std::atomic<uint32_t> ProducerBuffer;
+        // next buffer to consume
+        uint32_t ConsumerBuffer;
         // user facing structs
-        ShmDataBuffer sdbA;
-        ShmDataBuffer sdbB;
-        shm::Spinlock lockSegment;
-        // locks for individual buffers (sdb and buf)
-        shm::Spinlock lockA;
-        shm::Spinlock lockB;
-        // the actual data buffers
-        // char bufA[SHM_BUF_SIZE];
-        // char bufB[SHM_BUF_SIZE];
+        ShmDataBuffer sdb[MaxShmBuffers];
+        // the actual data buffers follow the struct
     };
     ShmSegment *m_Shm;
-    char *m_ShmBufA;
-    char *m_ShmBufB;
+    // the data buffers in the address space of this process
+    std::vector<char *> m_ShmBufs;
+    uint32_t m_ProducerBuffer = 0;
+    uint32_t m_ConsumerBuffer = 0;
 };
 
 } // end namespace aggregator
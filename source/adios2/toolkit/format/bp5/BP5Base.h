@@ -58,6 +58,18 @@ public:
         size_t *DataLengths;  // Per-block Lengths [BlockCount]
     } MetaArrayRecOperator;
 
+    /*
+     * Optional trailer of an array record when the writer computed
+     * statistics on sub-blocks (StatsBlockSize > 0).  Follows the MinMax
+     * pointer in the metadata record.
+     */
+    typedef struct _MetaArraySubBlockStats
+    {
+        size_t *SubBlockDivs;  // Per-block divisions per dim  [DBCount]
+        size_t SubBlockCount;  // Number of sub-blocks over all blocks
+        void *SubBlockMinMax;  // Per-sub-block Min/Max [2 * SubBlockCount]
+    } MetaArraySubBlockStats;
+
     struct BP5MetadataInfoStruct
     {
         size_t BitFieldCount;
@@ -65,6 +77,28 @@ public:
         size_t DataBlockSize;
     };
 
+    /*
+     * With delta encoded metadata (MetadataKeyframeInterval > 0) every
+     * metadata block starts with its kind.  A keyframe is followed by the
+     * FFS encoded block.  A delta is followed by the rest of the
+     * MetadataDeltaHeader and RunCount runs of {skip, length} and length
+     * bytes padded to 8, that turn the keyframe at KeyframePos in md.0 into
+     * the block of this step.
+     */
+    enum MetadataBlockKind : uint64_t
+    {
+        MetadataKeyframe = 0,
+        MetadataDelta = 1
+    };
+
+    struct MetadataDeltaHeader
+    {
+        uint64_t Kind;
+        uint64_t KeyframePos; // filled in by the rank writing md.0
+        uint64_t FullSize;
+        uint64_t RunCount;
+    };
+
     void BP5BitfieldSet(struct BP5MetadataInfoStruct *MBase, int Bit) const;
     int BP5BitfieldTest(struct BP5MetadataInfoStruct *MBase, int Bit) const;
 };
@@ -30,6 +30,10 @@
 
 #include "adios2/operator/OperatorFactory.h"
 
+#include <algorithm>
+#include <set>
+#include <tuple>
+
 #include <float.h>
 #include <limits.h>
 #include <math.h>
@@ -169,7 +173,9 @@ void BP5Deserializer::BreakdownVarName(const char *Name, char **base_name_p,
 
 void BP5Deserializer::BreakdownArrayName(const char *Name, char **base_name_p,
                                          DataType *type_p, int *element_size_p,
-                                         char **Operator, bool *MinMax)
+                                         char **Operator, bool *MinMax,
+                                         bool *SubBlockStats,
+                                         bool *Checksum)
 {
     int Type;
     int ElementSize;
@@ -179,6 +185,8 @@ void BP5Deserializer::BreakdownArrayName(const char *Name, char **base_name_p,
     const char *Plus = index(Name, '+');
     *Operator = NULL;
     *MinMax = false;
+    *SubBlockStats = false;
+    *Checksum = false;
     while (Plus && (*Plus == '+'))
     {
         int Len;
@@ -195,6 +203,24 @@ void BP5Deserializer::BreakdownArrayName(const char *Name, char **base_name_p,
             *MinMax = true;
             Plus += 3;
         }
+        else if (strncmp(Plus, "+SB", 3) == 0)
+        {
+            *SubBlockStats = true;
+            Plus += 3;
+        }
+        else if (strncmp(Plus, "+CK", 3) == 0)
+        {
+            *Checksum = true;
+            Plus += 3;
+        }
+        else
+        {
+            // the field layout of the record is unknown past this point
+            helper::Throw<std::runtime_error>(
+                "Toolkit", "format::BP5Deserializer", "BreakdownArrayName",
+                std::string("unknown metadata field specifier in ") + Name +
+                    ", the data was written by a newer version of ADIOS2");
+        }
     }
     *element_size_p = ElementSize;
     *type_p = (DataType)Type;
@@ -281,8 +307,11 @@ BP5Deserializer::ControlInfo *BP5Deserializer::BuildControl(FMFormat Format)
             int ElementSize;
             char *Operator = NULL;
             bool MinMax = false;
+            bool SubBlockStats = false;
+            bool Checksum = false;
             BreakdownArrayName(FieldList[i + 4].field_name, &ArrayName, &Type,
-                               &ElementSize, &Operator, &MinMax);
+                               &ElementSize, &Operator, &MinMax,
+                               &SubBlockStats, &Checksum);
             VarRec = LookupVarByName(ArrayName);
             if (!VarRec)
             {
@@ -305,6 +334,16 @@ BP5Deserializer::ControlInfo *BP5Deserializer::BuildControl(FMFormat Format)
                 VarRec->MinMaxOffset = MetaRecFields * sizeof(void *);
                 MetaRecFields++;
             }
+            if (SubBlockStats)
+            {
+                VarRec->SubBlockStatsOffset = MetaRecFields * sizeof(void *);
+                MetaRecFields += 3;
+            }
+            if (Checksum)
+            {
+                VarRec->ChecksumOffset = MetaRecFields * sizeof(void *);
+                MetaRecFields++;
+            }
             i += MetaRecFields;
             free(ArrayName);
         }
@@ -509,7 +548,7 @@ void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen,
         establish_conversion(ReaderFFSContext, FFSformat, List);
         FMfree_struct_list(List);
     }
-    if (FFSdecode_in_place_possible(FFSformat))
+    if (!m_MetadataIsShared && FFSdecode_in_place_possible(FFSformat))
     {
         FFSdecode_in_place(ReaderFFSContext, (char *)MetadataBlock, &BaseData);
     }
@@ -519,6 +558,10 @@ void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen,
             ReaderFFSContext, (char *)MetadataBlock, BlockLen);
         BaseData = malloc(DecodedLength);
         FFSdecode_to_buffer(ReaderFFSContext, (char *)MetadataBlock, BaseData);
+        if (m_StepInstaller || m_MetadataIsShared)
+        {
+            m_StepDecodeBuffers[Step].push_back(BaseData);
+        }
     }
     if (DumpMetadata == -1)
     {
@@ -555,11 +598,19 @@ void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen,
         MetadataBaseArray.resize(Step + 1);
         if (MetadataBaseArray[Step] == nullptr)
         {
-            m_MetadataBaseAddrs = new std::vector<void *>();
-            m_MetadataBaseAddrs->resize(writerCohortSize);
-            MetadataBaseArray[Step] = m_MetadataBaseAddrs;
+            MetadataBaseArray[Step] = new std::vector<void *>();
+            MetadataBaseArray[Step]->resize(writerCohortSize);
             m_FreeableMBA = nullptr;
         }
+        m_MetadataBaseAddrs = MetadataBaseArray[Step];
+        if (m_StepInstaller)
+        {
+            if (m_StepLastUse.size() < Step + 1)
+            {
+                m_StepLastUse.resize(Step + 1);
+            }
+            m_StepLastUse[Step] = ++m_StepUseCount;
+        }
     }
     else
     {
@@ -593,7 +644,7 @@ void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen,
             }
             VarRec->PerWriterMetaFieldOffset[WriterRank] = FieldOffset;
         }
-        else
+        else if (!m_Reinstalling)
         {
             if ((VarRec->AbsStepFromRel.size() == 0) ||
                 (VarRec->AbsStepFromRel.back() != Step))
@@ -618,10 +669,22 @@ void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen,
                 ReverseDimensions(meta_base->Offsets, meta_base->Dims,
                                   BlockCount);
             }
+            if (m_Reinstalling)
+            {
+                // step was indexed when first installed
+                continue;
+            }
             if ((WriterRank == 0) || (VarRec->GlobalDims == NULL))
             {
                 // use the shape from rank 0 (or first non-NULL)
                 VarRec->GlobalDims = meta_base->Shape;
+                if (m_StepInstaller && meta_base->Shape)
+                {
+                    // the metadata of the step may be evicted later
+                    VarRec->GlobalDimsCopy.assign(
+                        meta_base->Shape, meta_base->Shape + meta_base->Dims);
+                    VarRec->GlobalDims = VarRec->GlobalDimsCopy.data();
+                }
             }
             if (!VarRec->Variable)
             {
@@ -676,6 +739,10 @@ void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen,
         }
         else
         {
+            if (m_Reinstalling)
+            {
+                continue;
+            }
             if (!VarRec->Variable)
             {
                 if (ControlFields[i].OrigShapeID == ShapeID::LocalValue)
@@ -754,7 +821,9 @@ void BP5Deserializer::InstallAttributeData(void *AttributeBlock,
         FMfree_struct_list(List);
     }
 
-    if (FFSdecode_in_place_possible(FFSformat))
+    // the attributes copy their values, the decoded block is freed on return
+    std::vector<char> Decoded;
+    if (!m_MetadataIsShared && FFSdecode_in_place_possible(FFSformat))
     {
         FFSdecode_in_place(ReaderFFSContext, (char *)AttributeBlock, &BaseData);
     }
@@ -762,11 +831,10 @@ void BP5Deserializer::InstallAttributeData(void *AttributeBlock,
     {
         int DecodedLength = FFS_est_decode_length(
             ReaderFFSContext, (char *)AttributeBlock, BlockLen);
-        BaseData = malloc(DecodedLength);
-        FFSBuffer decode_buf =
-            create_fixed_FFSBuffer((char *)BaseData, DecodedLength);
+        Decoded.resize(DecodedLength);
+        BaseData = Decoded.data();
         FFSdecode_to_buffer(ReaderFFSContext, (char *)AttributeBlock,
-                            decode_buf);
+                            BaseData);
     }
     if (DumpMetadata == -1)
     {
@@ -1100,15 +1168,20 @@ BP5Deserializer::GenerateReadRequests()
         const size_t writerCohortSize = WriterCohortSize(Req.Step);
         for (size_t i = 0; i < writerCohortSize; i++)
         {
-            if (WriterTSNeeded.count(std::make_pair(Req.Step, i)) == 0)
+            bool &Needed = WriterTSNeeded[std::make_pair(Req.Step, i)];
+            if (!Needed)
             {
-                WriterTSNeeded[std::make_pair(Req.Step, i)] = true;
+                Needed = !DecompressedBlocksCached(Req, i);
             }
         }
     }
 
     for (std::pair<pair, bool> element : WriterTSNeeded)
     {
+        if (!element.second)
+        {
+            continue; // every block needed from this writer is cached
+        }
         ReadRequest RR;
         RR.Timestep = element.first.first;
         RR.WriterRank = element.first.second;
@@ -1133,8 +1206,124 @@ BP5Deserializer::GenerateReadRequests()
     return Ret;
 }
 
+static bool BlockIntersects(size_t DimCount, const size_t *BlockOffset,
+                            const size_t *BlockCount, const size_t *SelOffset,
+                            const size_t *SelCount)
+{
+    for (size_t d = 0; d < DimCount; d++)
+    {
+        if ((BlockOffset[d] >= SelOffset[d] + SelCount[d]) ||
+            (SelOffset[d] >= BlockOffset[d] + BlockCount[d]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BP5Deserializer::CachesDecompressed(const BP5ArrayRequest &Req) const
+{
+    return m_DecompressedCacheSize > 0 && Req.VarRec->Operator != NULL &&
+           Req.RequestType == Global && Req.Start.size() && Req.Count.size();
+}
+
+bool BP5Deserializer::DecompressedBlocksCached(const BP5ArrayRequest &Req,
+                                               size_t WriterRank) const
+{
+    if (!CachesDecompressed(Req))
+    {
+        return false;
+    }
+    const MetaArrayRec *writer_meta_base =
+        (MetaArrayRec *)GetMetadataBase(Req.VarRec, Req.Step, WriterRank);
+    if (!writer_meta_base || writer_meta_base->DataLocation == NULL)
+    {
+        return true; // nothing written by this writer
+    }
+    const size_t DimCount = writer_meta_base->Dims;
+    for (size_t Block = 0; Block < writer_meta_base->BlockCount; Block++)
+    {
+        if (BlockIntersects(DimCount,
+                            &writer_meta_base->Offsets[Block * DimCount],
+                            &writer_meta_base->Count[Block * DimCount],
+                            Req.Start.data(), Req.Count.data()) &&
+            !m_DecompressedIndex.count(
+                BlockKey(Req.VarRec, Req.Step, WriterRank, Block)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<char> *
+BP5Deserializer::FindDecompressedBlock(const BlockKey &Key)
+{
+    auto it = m_DecompressedIndex.find(Key);
+    if (it == m_DecompressedIndex.end())
+    {
+        return nullptr;
+    }
+    m_DecompressedBlocks.splice(m_DecompressedBlocks.begin(),
+                                m_DecompressedBlocks, it->second);
+    return &it->second->second;
+}
+
+std::vector<char> &
+BP5Deserializer::AddDecompressedBlock(const BlockKey &Key,
+                                      std::vector<char> &&Block)
+{
+    m_DecompressedBytes += Block.size();
+    m_DecompressedBlocks.emplace_front(Key, std::move(Block));
+    m_DecompressedIndex[Key] = m_DecompressedBlocks.begin();
+    return m_DecompressedBlocks.front().second;
+}
+
+void BP5Deserializer::TrimDecompressedBlocks()
+{
+    while (m_DecompressedBytes > m_DecompressedCacheSize &&
+           !m_DecompressedBlocks.empty())
+    {
+        m_DecompressedBytes -= m_DecompressedBlocks.back().second.size();
+        m_DecompressedIndex.erase(m_DecompressedBlocks.back().first);
+        m_DecompressedBlocks.pop_back();
+    }
+}
+
+bool BP5Deserializer::VerifyBlockChecksum(const BP5VarRec *VarRec,
+                                          const MetaArrayRec *writer_meta_base,
+                                          size_t Block, const char *Data) const
+{
+    const size_t Expected = (*(size_t **)(((char *)writer_meta_base) +
+                                          VarRec->ChecksumOffset))[Block];
+    if (Expected == (size_t)-1)
+    {
+        return true; // writer could not checksum this block (GPU memory)
+    }
+    size_t Length;
+    if (VarRec->Operator != NULL)
+    {
+        Length =
+            ((MetaArrayRecOperator *)writer_meta_base)->DataLengths[Block];
+    }
+    else
+    {
+        Length = VarRec->ElementSize;
+        for (size_t d = 0; d < writer_meta_base->Dims; d++)
+        {
+            Length *= writer_meta_base->Count[Block * writer_meta_base->Dims +
+                                              d];
+        }
+    }
+    return helper::Crc32c(Data, Length) == Expected;
+}
+
 void BP5Deserializer::FinalizeGets(std::vector<ReadRequest> Requests)
 {
+    // (variable, step, writer, block) already checked in this call
+    std::set<std::tuple<const BP5VarRec *, size_t, size_t, size_t>>
+        VerifiedBlocks;
+    std::string ChecksumError;
     for (const auto &Req : PendingRequests)
     {
         // ImplementGapWarning(Reqs);
@@ -1168,21 +1357,82 @@ void BP5Deserializer::FinalizeGets(std::vector<ReadRequest> Requests)
                     std::vector<size_t> ZeroGlobalDimensions(DimCount);
                     const size_t *SelOffset = NULL;
                     const size_t *SelSize = NULL;
-                    int ReqIndex = 0;
-                    while (Requests[ReqIndex].WriterRank !=
-                               static_cast<size_t>(WriterRank) ||
-                           (Requests[ReqIndex].Timestep != Req.Step))
-                        ReqIndex++;
                     if (writer_meta_base->DataLocation == NULL)
                     {
                         // No Data from this writer
                         continue;
                     }
+                    /* a cached block is used as it was decompressed, and
+                     * the writer is only read if a block is missing */
+                    const bool Cacheable = CachesDecompressed(Req);
+                    if (Cacheable &&
+                        !BlockIntersects(DimCount, RankOffset, RankSize,
+                                         Req.Start.data(), Req.Count.data()))
+                    {
+                        continue;
+                    }
+                    const BlockKey Key(Req.VarRec, Req.Step, WriterRank,
+                                       Block);
+                    std::vector<char> *CachedBlock =
+                        Cacheable ? FindDecompressedBlock(Key) : nullptr;
+                    size_t ReqIndex = 0;
+                    while (!CachedBlock &&
+                           (Requests[ReqIndex].WriterRank != WriterRank ||
+                            Requests[ReqIndex].Timestep != Req.Step))
+                        ReqIndex++;
+                    /* The checksum covers the whole stored block while
+                     * the extraction below copies only the selected part,
+                     * and the read fills the request buffer by file reads
+                     * of whole writer ranges, so there is no copy of the
+                     * block to fold the checksum into.  Verifying each
+                     * block right before its extraction leaves it in cache
+                     * for the copy. */
+                    if (Req.VarRec->ChecksumOffset != SIZE_MAX &&
+                        !CachedBlock)
+                    {
+                        size_t DataBlock = Block;
+                        bool Needed = true;
+                        if (Req.RequestType == Local)
+                        {
+                            DataBlock = Req.BlockID - NodeFirst;
+                        }
+                        else if (Req.Start.size() && Req.Count.size())
+                        {
+                            Needed = BlockIntersects(
+                                DimCount, RankOffset, RankSize,
+                                Req.Start.data(), Req.Count.data());
+                        }
+                        if (Needed &&
+                            VerifiedBlocks
+                                .insert(std::make_tuple(Req.VarRec, Req.Step,
+                                                        WriterRank, DataBlock))
+                                .second &&
+                            !VerifyBlockChecksum(
+                                Req.VarRec, writer_meta_base, DataBlock,
+                                (char *)Requests[ReqIndex].DestinationAddr +
+                                    writer_meta_base->DataLocation[DataBlock]))
+                        {
+                            if (ChecksumError.empty())
+                            {
+                                ChecksumError =
+                                    "checksum mismatch in block " +
+                                    std::to_string(DataBlock) +
+                                    " of variable " + Req.VarRec->VarName +
+                                    " written by rank " +
+                                    std::to_string(WriterRank) + " in step " +
+                                    std::to_string(Req.Step) +
+                                    ", the data is corrupted";
+                            }
+                            continue;
+                        }
+                    }
                     char *IncomingData =
-                        (char *)Requests[ReqIndex].DestinationAddr +
-                        writer_meta_base->DataLocation[Block];
+                        CachedBlock
+                            ? CachedBlock->data()
+                            : (char *)Requests[ReqIndex].DestinationAddr +
+                                  writer_meta_base->DataLocation[Block];
                     std::vector<char> decompressBuffer;
-                    if (Req.VarRec->Operator != NULL)
+                    if (Req.VarRec->Operator != NULL && !CachedBlock)
                     {
                         size_t DestSize = Req.VarRec->ElementSize;
                         for (size_t dim = 0; dim < Req.VarRec->DimCount; dim++)
@@ -1198,7 +1448,11 @@ void BP5Deserializer::FinalizeGets(std::vector<ReadRequest> Requests)
                             ((MetaArrayRecOperator *)writer_meta_base)
                                 ->DataLengths[Block],
                             decompressBuffer.data());
-                        IncomingData = decompressBuffer.data();
+                        IncomingData =
+                            Cacheable ? AddDecompressedBlock(
+                                            Key, std::move(decompressBuffer))
+                                            .data()
+                                      : decompressBuffer.data();
                     }
                     if (Req.Start.size())
                     {
@@ -1253,6 +1507,14 @@ void BP5Deserializer::FinalizeGets(std::vector<ReadRequest> Requests)
         free((char *)Req.DestinationAddr);
     }
     PendingRequests.clear();
+    // blocks used in this call stay until here, so the budget is exceeded
+    // at most by the blocks of one call
+    TrimDecompressedBlocks();
+    if (!ChecksumError.empty())
+    {
+        helper::Throw<std::runtime_error>("Toolkit", "format::BP5Deserializer",
+                                          "FinalizeGets", ChecksumError);
+    }
 }
 
 void BP5Deserializer::MapGlobalToLocalIndex(size_t Dims,
@@ -1565,6 +1827,80 @@ BP5Deserializer::~BP5Deserializer()
     {
         delete step;
     }
+    for (auto &buffers : m_StepDecodeBuffers)
+    {
+        for (auto buffer : buffers.second)
+        {
+            free(buffer);
+        }
+    }
+}
+
+void BP5Deserializer::SetStepInstaller(
+    std::function<void(size_t Step)> Installer)
+{
+    m_StepInstaller = std::move(Installer);
+}
+
+void BP5Deserializer::ReinstallMetaData(void *MetadataBlock, size_t BlockLen,
+                                        size_t WriterRank, size_t Step)
+{
+    m_Reinstalling = true;
+    try
+    {
+        InstallMetaData(MetadataBlock, BlockLen, WriterRank, Step);
+    }
+    catch (...)
+    {
+        m_Reinstalling = false;
+        throw;
+    }
+    m_Reinstalling = false;
+}
+
+void BP5Deserializer::EvictStep(size_t Step)
+{
+    if ((Step >= MetadataBaseArray.size()) ||
+        (MetadataBaseArray[Step] == nullptr))
+    {
+        return;
+    }
+    auto it = m_StepDecodeBuffers.find(Step);
+    if (it != m_StepDecodeBuffers.end())
+    {
+        for (auto buffer : it->second)
+        {
+            free(buffer);
+        }
+        m_StepDecodeBuffers.erase(it);
+    }
+    if (m_MetadataBaseAddrs == MetadataBaseArray[Step])
+    {
+        m_MetadataBaseAddrs = nullptr;
+    }
+    delete MetadataBaseArray[Step];
+    MetadataBaseArray[Step] = nullptr;
+    if (Step < m_StepLastUse.size())
+    {
+        m_StepLastUse[Step] = 0;
+    }
+}
+
+std::vector<size_t> BP5Deserializer::InstalledStepsByUse() const
+{
+    std::vector<size_t> steps;
+    for (size_t Step = 0; Step < m_StepLastUse.size(); Step++)
+    {
+        if (m_StepLastUse[Step] && (Step < MetadataBaseArray.size()) &&
+            MetadataBaseArray[Step])
+        {
+            steps.push_back(Step);
+        }
+    }
+    std::sort(steps.begin(), steps.end(), [this](size_t a, size_t b) {
+        return m_StepLastUse[a] < m_StepLastUse[b];
+    });
+    return steps;
 }
 
 void *BP5Deserializer::GetMetadataBase(BP5VarRec *VarRec, size_t Step,
@@ -1581,6 +1917,14 @@ void *BP5Deserializer::GetMetadataBase(BP5VarRec *VarRec, size_t Step,
             // Var does not appear in this record
             return NULL;
         }
+        if (m_StepInstaller)
+        {
+            if (MetadataBaseArray[Step] == nullptr)
+            {
+                m_StepInstaller(Step);
+            }
+            m_StepLastUse[Step] = ++m_StepUseCount;
+        }
         size_t CI_VarIndex = (*CI->CIVarIndex)[VarRec->VarNum];
         BP5MetadataInfoStruct *BaseData =
             (BP5MetadataInfoStruct *)(*MetadataBaseArray[Step])[WriterRank];
@@ -1694,6 +2038,13 @@ MinVarInfo *BP5Deserializer::MinBlocksInfo(const VariableBase &Var, size_t Step)
             MMs = *(MinMaxStruct **)(((char *)writer_meta_base) +
                                      VarRec->MinMaxOffset);
         }
+        MetaArraySubBlockStats *SBStats = NULL;
+        size_t SubBlockStart = 0;
+        if (VarRec->SubBlockStatsOffset != SIZE_MAX)
+        {
+            SBStats = (MetaArraySubBlockStats *)(((char *)writer_meta_base) +
+                                                 VarRec->SubBlockStatsOffset);
+        }
         for (size_t i = 0; i < WriterBlockCount; i++)
         {
             size_t *Offsets = NULL;
@@ -1708,6 +2059,18 @@ MinVarInfo *BP5Deserializer::MinBlocksInfo(const VariableBase &Var, size_t Step)
             Blk.Start = Offsets;
             Blk.Count = Count;
             Blk.MinMax.Init(VarRec->Type);
+            if (SBStats && !MV->IsReverseDims)
+            {
+                Blk.SubBlockDivs = SBStats->SubBlockDivs + (i * MV->Dims);
+                Blk.SubBlockCount = 1;
+                for (int d = 0; d < MV->Dims; d++)
+                {
+                    Blk.SubBlockCount *= Blk.SubBlockDivs[d];
+                }
+                Blk.SubBlockMinMax = ((char *)SBStats->SubBlockMinMax) +
+                                     2 * SubBlockStart * VarRec->ElementSize;
+                SubBlockStart += Blk.SubBlockCount;
+            }
             if (MMs)
             {
 
@@ -1851,6 +2214,14 @@ void BP5Deserializer::GetAbsoluteSteps(const VariableBase &Var,
     if (!m_RandomAccessMode)
         return;
 
+    if (m_StepInstaller)
+    {
+        // steps were indexed at install, no need to touch their metadata
+        keys.insert(keys.end(), VarRec->AbsStepFromRel.begin(),
+                    VarRec->AbsStepFromRel.end());
+        return;
+    }
+
     for (size_t Step = 0; Step < m_ControlArray.size(); Step++)
     {
         for (size_t WriterRank = 0; WriterRank < WriterCohortSize(Step);
@@ -18,6 +18,11 @@
 #include "ffs.h"
 #include "fm.h"
 
+#include <functional>
+#include <list>
+#include <map>
+#include <tuple>
+
 #ifdef _WIN32
 #pragma warning(disable : 4250)
 #endif
@@ -70,9 +75,29 @@ public:
     void GetAbsoluteSteps(const VariableBase &variable,
                           std::vector<size_t> &keys) const;
 
+    /*
+     * Random access mode only.  With an installer set, the metadata of a
+     * step that was evicted is installed again through it on first use.
+     * Variables and their steps are indexed when a step is first installed,
+     * ReinstallMetaData() only makes the metadata of the step available again.
+     */
+    void SetStepInstaller(std::function<void(size_t Step)> Installer);
+    void ReinstallMetaData(void *MetadataBlock, size_t BlockLen,
+                           size_t WriterRank, size_t Step);
+    void EvictStep(size_t Step);
+    // installed steps, least recently used first
+    std::vector<size_t> InstalledStepsByUse() const;
+
     const bool m_WriterIsRowMajor;
     const bool m_ReaderIsRowMajor;
     core::Engine *m_Engine = NULL;
+    /* metadata blocks live in memory shared with other processes and are
+     * decoded into private buffers instead of in place */
+    bool m_MetadataIsShared = false;
+    /* bytes of decompressed blocks of variables with an operator kept for
+     * later Gets of the same blocks, least recently used dropped first;
+     * 0 decompresses every block again on every Get */
+    size_t m_DecompressedCacheSize = 0;
 
 private:
     size_t m_VarCount = 0;
@@ -87,7 +112,10 @@ private:
         DataType Type;
         int ElementSize = 0;
         size_t MinMaxOffset = SIZE_MAX;
+        size_t SubBlockStatsOffset = SIZE_MAX;
+        size_t ChecksumOffset = SIZE_MAX;
         size_t *GlobalDims = NULL;
+        std::vector<size_t> GlobalDimsCopy; // when metadata can be evicted
         size_t LastTSAdded = SIZE_MAX;
         size_t FirstTSSeen = SIZE_MAX;
         size_t LastStepAdded = SIZE_MAX;
@@ -155,6 +183,14 @@ private:
     // address of the metadata
     std::vector<std::vector<void *> *> MetadataBaseArray;
 
+    // for random access mode with evictable steps
+    std::function<void(size_t Step)> m_StepInstaller;
+    bool m_Reinstalling = false;
+    mutable std::vector<uint64_t> m_StepLastUse; // 0 when not installed
+    mutable uint64_t m_StepUseCount = 0;
+    // metadata decoded out of place, freed when the step is evicted
+    std::unordered_map<size_t, std::vector<void *>> m_StepDecodeBuffers;
+
     ControlInfo *ControlBlocks = nullptr;
     ControlInfo *GetPriorControl(FMFormat Format);
     ControlInfo *BuildControl(FMFormat Format);
@@ -169,7 +205,8 @@ private:
                           DataType *type_p, int *element_size_p);
     void BreakdownArrayName(const char *Name, char **base_name_p,
                             DataType *type_p, int *element_size_p,
-                            char **Operator, bool *MinMax);
+                            char **Operator, bool *MinMax,
+                            bool *SubBlockStats, bool *Checksum);
     void *VarSetup(core::Engine *engine, const char *variableName,
                    const DataType type, void *data);
     void *ArrayVarSetup(core::Engine *engine, const char *variableName,
@@ -216,6 +253,25 @@ private:
     };
     std::vector<BP5ArrayRequest> PendingRequests;
     bool NeedWriter(BP5ArrayRequest Req, size_t i, size_t &NodeFirst);
+
+    // (variable, step, writer rank, block) of a decompressed block
+    typedef std::tuple<const BP5VarRec *, size_t, size_t, size_t> BlockKey;
+    // most recently used first
+    std::list<std::pair<BlockKey, std::vector<char>>> m_DecompressedBlocks;
+    std::map<BlockKey, decltype(m_DecompressedBlocks)::iterator>
+        m_DecompressedIndex;
+    size_t m_DecompressedBytes = 0;
+    bool CachesDecompressed(const BP5ArrayRequest &Req) const;
+    // true if no block of the writer needed by Req has to be read
+    bool DecompressedBlocksCached(const BP5ArrayRequest &Req,
+                                  size_t WriterRank) const;
+    std::vector<char> *FindDecompressedBlock(const BlockKey &Key);
+    std::vector<char> &AddDecompressedBlock(const BlockKey &Key,
+                                            std::vector<char> &&Block);
+    void TrimDecompressedBlocks();
+    bool VerifyBlockChecksum(const BP5VarRec *VarRec,
+                             const MetaArrayRec *writer_meta_base,
+                             size_t Block, const char *Data) const;
     void *GetMetadataBase(BP5VarRec *VarRec, size_t Step,
                           size_t WriterRank) const;
     size_t CurTimestep = 0;
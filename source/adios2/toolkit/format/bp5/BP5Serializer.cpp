@@ -16,6 +16,7 @@
 
 #include <stddef.h> // max_align_t
 
+#include <algorithm>
 #include <cstring>
 
 #include "BP5Serializer.h"
@@ -258,7 +259,8 @@ static char *BuildShortName(const ShapeID Shape, const int Index,
 
 static char *BuildLongName(const char *base_name, const ShapeID Shape,
                            const int type, const int element_size,
-                           const char *Operator, bool MinMax)
+                           const char *Operator, bool MinMax,
+                           bool SubBlockStats, bool Checksum)
 {
     const char *Prefix = NamePrefix(Shape);
     int Len = strlen(base_name) + 3 + strlen(Prefix) + 16;
@@ -278,6 +280,18 @@ static char *BuildLongName(const char *base_name, const ShapeID Shape,
         Ret = (char *)realloc(Ret, Len);
         strcat(Ret, "+MM");
     }
+    if (SubBlockStats)
+    {
+        Len += 3;
+        Ret = (char *)realloc(Ret, Len);
+        strcat(Ret, "+SB");
+    }
+    if (Checksum)
+    {
+        Len += 3;
+        Ret = (char *)realloc(Ret, Len);
+        strcat(Ret, "+CK");
+    }
     strcat(Ret, "_");
     strcat(Ret, base_name);
     return Ret;
@@ -429,6 +443,8 @@ BP5Serializer::CreateWriterRec(void *Variable, const char *Name, DataType Type,
     Rec->DimCount = DimCount;
     Rec->Type = (int)Type;
     Rec->OperatorType = NULL;
+    Rec->SubBlockStatsOffset = (size_t)-1;
+    Rec->ChecksumOffset = (size_t)-1;
     if (DimCount == 0)
     {
         // simple field, only add base value FMField to metadata
@@ -450,11 +466,15 @@ BP5Serializer::CreateWriterRec(void *Variable, const char *Name, DataType Type,
         {
             OperatorType = strdup((VB->m_Operations[0])->m_TypeString.data());
         }
+        const bool SubBlockStats =
+            (m_StatsLevel > 0) && (m_StatsBlockSize > 0) &&
+            (Type != DataType::FloatComplex) &&
+            (Type != DataType::DoubleComplex) && (Type != DataType::String);
         // Array field.  To Metadata, add FMFields for DimCount, Shape, Count
         // and Offsets matching _MetaArrayRec
-        char *LongName =
-            BuildLongName(Name, VB->m_ShapeID, (int)Type, ElemSize,
-                          OperatorType, /* minmax */ (m_StatsLevel > 0));
+        char *LongName = BuildLongName(
+            Name, VB->m_ShapeID, (int)Type, ElemSize, OperatorType,
+            /* minmax */ (m_StatsLevel > 0), SubBlockStats, m_DataChecksum);
         char *DimsName = BuildShortName(VB->m_ShapeID, Info.RecCount, "Dims");
         char *BlockCountName =
             BuildShortName(VB->m_ShapeID, Info.RecCount, "BlockCount");
@@ -470,6 +490,14 @@ BP5Serializer::CreateWriterRec(void *Variable, const char *Name, DataType Type,
             BuildShortName(VB->m_ShapeID, Info.RecCount, "DataLengths");
         char *MinMaxName =
             BuildShortName(VB->m_ShapeID, Info.RecCount, "MinMax");
+        char *SubBlockDivsName =
+            BuildShortName(VB->m_ShapeID, Info.RecCount, "SubBlockDivs");
+        char *SubBlockCountName =
+            BuildShortName(VB->m_ShapeID, Info.RecCount, "SubBlockCount");
+        char *SubBlockMinMaxName =
+            BuildShortName(VB->m_ShapeID, Info.RecCount, "SubBlockMinMax");
+        char *ChecksumsName =
+            BuildShortName(VB->m_ShapeID, Info.RecCount, "DataChecksums");
         AddField(&Info.MetaFields, &Info.MetaFieldCount, DimsName,
                  DataType::Int64, sizeof(size_t));
         Rec->MetaOffset = Info.MetaFields[Info.MetaFieldCount - 1].field_offset;
@@ -498,6 +526,27 @@ BP5Serializer::CreateWriterRec(void *Variable, const char *Name, DataType Type,
             Rec->MinMaxOffset = Offset;
             AddDoubleArrayField(&Info.MetaFields, &Info.MetaFieldCount,
                                 MinMaxName, Type, ElemSize, BlockCountName);
+            Offset += sizeof(void *);
+        }
+        if (SubBlockStats)
+        {
+            Rec->SubBlockStatsOffset = Offset;
+            AddVarArrayField(&Info.MetaFields, &Info.MetaFieldCount,
+                             SubBlockDivsName, DataType::Int64, sizeof(size_t),
+                             ArrayDBCount);
+            AddField(&Info.MetaFields, &Info.MetaFieldCount, SubBlockCountName,
+                     DataType::Int64, sizeof(size_t));
+            AddDoubleArrayField(&Info.MetaFields, &Info.MetaFieldCount,
+                                SubBlockMinMaxName, Type, ElemSize,
+                                SubBlockCountName);
+            Offset += sizeof(MetaArraySubBlockStats);
+        }
+        if (m_DataChecksum)
+        {
+            Rec->ChecksumOffset = Offset;
+            AddVarArrayField(&Info.MetaFields, &Info.MetaFieldCount,
+                             ChecksumsName, DataType::Int64, sizeof(size_t),
+                             BlockCountName);
         }
         Rec->OperatorType = OperatorType;
         free(LongName);
@@ -510,6 +559,10 @@ BP5Serializer::CreateWriterRec(void *Variable, const char *Name, DataType Type,
         free(LocationsName);
         free(LengthsName);
         free(MinMaxName);
+        free(SubBlockDivsName);
+        free(SubBlockCountName);
+        free(SubBlockMinMaxName);
+        free(ChecksumsName);
         RecalcMarshalStorageSize();
 
         // Changing the formats renders these invalid
@@ -560,15 +613,50 @@ void BP5Serializer::DumpDeferredBlocks(bool forceCopyDeferred)
     {
         MetaArrayRec *MetaEntry =
             (MetaArrayRec *)((char *)(MetadataBuf) + Def.MetaOffset);
+        uint32_t Checksum;
+        const bool WantChecksum = (Def.ChecksumOffset != (size_t)-1);
         size_t DataOffset =
             m_PriorDataBufferSizeTotal +
             CurDataBuffer->AddToVec(Def.DataSize, Def.Data, Def.AlignReq,
-                                    forceCopyDeferred);
+                                    forceCopyDeferred, MemorySpace::Host,
+                                    WantChecksum ? &Checksum : nullptr);
         MetaEntry->DataLocation[Def.BlockID] = DataOffset;
+        if (WantChecksum)
+        {
+            DataChecksums(MetaEntry, Def.ChecksumOffset)[Def.BlockID] =
+                Checksum;
+        }
     }
     DeferredExterns.clear();
 }
 
+size_t *&BP5Serializer::DataChecksums(MetaArrayRec *MetaEntry,
+                                      size_t ChecksumOffset)
+{
+    return *(size_t **)(((char *)MetaEntry) + ChecksumOffset);
+}
+
+/*
+ * Span blocks are filled by the application between Marshal and EndStep (or
+ * a flush), so their checksums can only be computed here.
+ */
+void BP5Serializer::ChecksumSpans()
+{
+    for (auto &Def : DeferredSpanChecksums)
+    {
+        MetaArrayRec *MetaEntry =
+            (MetaArrayRec *)((char *)(MetadataBuf) + Def.MetaOffset);
+        uint32_t Checksum = 0;
+        if (Def.DataSize)
+        {
+            Checksum = helper::Crc32c(GetPtr(Def.BufferIdx, Def.PosInBuffer),
+                                      Def.DataSize);
+        }
+        DataChecksums(MetaEntry, Def.ChecksumOffset)[Def.BlockID] = Checksum;
+    }
+    DeferredSpanChecksums.clear();
+}
+
 static void GetMinMax(const void *Data, size_t ElemCount, const DataType Type,
                       MinMaxStruct &MinMax, MemorySpace MemSpace)
 {
@@ -600,6 +688,93 @@ static void GetMinMax(const void *Data, size_t ElemCount, const DataType Type,
         MinMax.MaxUnion.field_##N = *res.second;                               \
     }
     ADIOS2_FOREACH_MINMAX_STDTYPE_2ARGS(pertype)
+#undef pertype
+}
+
+/*
+ * Like GetMinMax(), but divides the block into sub-blocks of roughly
+ * StatsBlockSize elements (helper::DivideBlock) and also returns the
+ * division of each dimension and a Min/Max pair for every sub-block.
+ * Blocks that are not divided get a single sub-block carrying the block
+ * Min/Max.
+ */
+static void GetSubBlockMinMax(const void *Data, size_t DimCount,
+                              const size_t *Count, const DataType Type,
+                              size_t ElemSize, size_t StatsBlockSize,
+                              MinMaxStruct &MinMax,
+                              std::vector<size_t> &SubBlockDivs,
+                              std::vector<char> &SubBlockMinMax,
+                              MemorySpace MemSpace)
+{
+    const Dims BlockCount(Count, Count + DimCount);
+    const size_t ElemCount = helper::GetTotalSize(BlockCount);
+    SubBlockDivs.assign(DimCount, 1);
+    helper::BlockDivisionInfo SubBlockInfo;
+    SubBlockInfo.NBlocks = 1;
+    if ((ElemCount > StatsBlockSize) && (MemSpace == MemorySpace::Host))
+    {
+        SubBlockInfo = helper::DivideBlock(
+            BlockCount, StatsBlockSize, helper::BlockDivisionMethod::Contiguous);
+    }
+    if (SubBlockInfo.NBlocks <= 1)
+    {
+        GetMinMax(Data, ElemCount, Type, MinMax, MemSpace);
+        SubBlockMinMax.resize(2 * ElemSize);
+        memcpy(SubBlockMinMax.data(), &MinMax.MinUnion, ElemSize);
+        memcpy(SubBlockMinMax.data() + ElemSize, &MinMax.MaxUnion, ElemSize);
+        return;
+    }
+    for (size_t i = 0; i < DimCount; i++)
+    {
+        SubBlockDivs[i] = SubBlockInfo.Div[i];
+    }
+    MinMax.Init(Type);
+    if (Type == DataType::Compound)
+    {
+    }
+#define pertype(T, N)                                                          \
+    else if (Type == helper::GetDataType<T>())                                 \
+    {                                                                          \
+        std::vector<T> MinMaxs;                                                \
+        helper::GetMinMaxSubblocks((const T *)Data, BlockCount, SubBlockInfo,  \
+                                   MinMaxs, MinMax.MinUnion.field_##N,         \
+                                   MinMax.MaxUnion.field_##N, 1);              \
+        SubBlockMinMax.resize(MinMaxs.size() * sizeof(T));                     \
+        memcpy(SubBlockMinMax.data(), MinMaxs.data(), SubBlockMinMax.size());  \
+    }
+    ADIOS2_FOREACH_MINMAX_STDTYPE_2ARGS(pertype)
+#undef pertype
+    else
+    {
+        // no statistics for this type, keep a single (empty) sub-block
+        SubBlockDivs.assign(DimCount, 1);
+        SubBlockMinMax.resize(2 * ElemSize);
+        memcpy(SubBlockMinMax.data(), &MinMax.MinUnion, ElemSize);
+        memcpy(SubBlockMinMax.data() + ElemSize, &MinMax.MaxUnion, ElemSize);
+    }
+}
+
+void BP5Serializer::AppendSubBlockStats(BP5WriterRec Rec,
+                                        MetaArrayRec *MetaEntry,
+                                        size_t PreviousDBCount,
+                                        size_t ElemSize,
+                                        const std::vector<size_t> &SubBlockDivs,
+                                        const std::vector<char> &SubBlockMinMax)
+{
+    MetaArraySubBlockStats *SBEntry =
+        (MetaArraySubBlockStats *)(((char *)MetaEntry) +
+                                   Rec->SubBlockStatsOffset);
+    SBEntry->SubBlockDivs =
+        AppendDims(SBEntry->SubBlockDivs, PreviousDBCount,
+                   SubBlockDivs.size(), SubBlockDivs.data());
+    const size_t NewCount = SubBlockMinMax.size() / (2 * ElemSize);
+    SBEntry->SubBlockMinMax = realloc(
+        SBEntry->SubBlockMinMax,
+        (SBEntry->SubBlockCount + NewCount) * 2 * ElemSize);
+    memcpy(((char *)SBEntry->SubBlockMinMax) +
+               SBEntry->SubBlockCount * 2 * ElemSize,
+           SubBlockMinMax.data(), SubBlockMinMax.size());
+    SBEntry->SubBlockCount += NewCount;
 }
 
 void BP5Serializer::Marshal(void *Variable, const char *Name,
@@ -669,6 +844,10 @@ void BP5Serializer::Marshal(void *Variable, const char *Name,
         size_t ElemCount = CalcSize(DimCount, Count);
         size_t DataOffset = 0;
         size_t CompressedSize = 0;
+        /* CRC-32C of the stored block, (size_t)-1 if none was computed */
+        size_t BlockChecksum = (size_t)-1;
+        const bool WantChecksum = (Rec->ChecksumOffset != (size_t)-1) &&
+                                  (VB->m_MemorySpace != MemorySpace::CUDA);
         /* handle metadata */
         MetaEntry->Dims = DimCount;
         if (CurDataBuffer == NULL)
@@ -679,7 +858,28 @@ void BP5Serializer::Marshal(void *Variable, const char *Name,
 
         MinMaxStruct MinMax;
         MinMax.Init(Type);
-        if ((m_StatsLevel > 0) && !Span)
+        std::vector<size_t> SubBlockDivs;
+        std::vector<char> SubBlockMinMax;
+        if (Rec->SubBlockStatsOffset != (size_t)-1)
+        {
+            if (Span)
+            {
+                // data is not available yet, single sub-block
+                SubBlockDivs.assign(DimCount, 1);
+                SubBlockMinMax.resize(2 * ElemSize);
+                memcpy(SubBlockMinMax.data(), &MinMax.MinUnion, ElemSize);
+                memcpy(SubBlockMinMax.data() + ElemSize, &MinMax.MaxUnion,
+                       ElemSize);
+            }
+            else
+            {
+                GetSubBlockMinMax(Data, DimCount, Count, (DataType)Rec->Type,
+                                  ElemSize, m_StatsBlockSize, MinMax,
+                                  SubBlockDivs, SubBlockMinMax,
+                                  VB->m_MemorySpace);
+            }
+        }
+        else if ((m_StatsLevel > 0) && !Span)
         {
             GetMinMax(Data, ElemCount, (DataType)Rec->Type, MinMax,
                       VB->m_MemorySpace);
@@ -706,15 +906,25 @@ void BP5Serializer::Marshal(void *Variable, const char *Name,
                 (const char *)Data, tmpOffsets, tmpCount, (DataType)Rec->Type,
                 CompressedData);
             CurDataBuffer->DownsizeLastAlloc(AllocSize, CompressedSize);
+            if (WantChecksum)
+            {
+                BlockChecksum = helper::Crc32c(CompressedData, CompressedSize);
+            }
         }
         else if (Span == nullptr)
         {
             if (!DeferAddToVec)
             {
+                uint32_t Checksum;
                 DataOffset =
                     m_PriorDataBufferSizeTotal +
                     CurDataBuffer->AddToVec(ElemCount * ElemSize, Data,
-                                            ElemSize, Sync, VB->m_MemorySpace);
+                                            ElemSize, Sync, VB->m_MemorySpace,
+                                            WantChecksum ? &Checksum : nullptr);
+                if (WantChecksum)
+                {
+                    BlockChecksum = Checksum;
+                }
             }
         }
         else
@@ -754,10 +964,16 @@ void BP5Serializer::Marshal(void *Variable, const char *Name,
                 memcpy(((char *)*MMPtrLoc) + ElemSize, &MinMax.MaxUnion,
                        ElemSize);
             }
+            if (Rec->SubBlockStatsOffset != (size_t)-1)
+            {
+                AppendSubBlockStats(Rec, MetaEntry, 0, ElemSize, SubBlockDivs,
+                                    SubBlockMinMax);
+            }
             if (DeferAddToVec)
             {
-                DeferredExtern rec = {Rec->MetaOffset, 0, Data,
-                                      ElemCount * ElemSize, ElemSize};
+                DeferredExtern rec = {
+                    Rec->MetaOffset, 0, Data, ElemCount * ElemSize, ElemSize,
+                    WantChecksum ? Rec->ChecksumOffset : (size_t)-1};
                 DeferredExterns.push_back(rec);
             }
         }
@@ -803,16 +1019,36 @@ void BP5Serializer::Marshal(void *Variable, const char *Name,
                            ElemSize * (2 * (MetaEntry->BlockCount - 1) + 1),
                        &MinMax.MaxUnion, ElemSize);
             }
+            if (Rec->SubBlockStatsOffset != (size_t)-1)
+            {
+                AppendSubBlockStats(Rec, MetaEntry, PreviousDBCount, ElemSize,
+                                    SubBlockDivs, SubBlockMinMax);
+            }
             if (DeferAddToVec)
             {
-                DeferredExterns.push_back({Rec->MetaOffset,
-                                           MetaEntry->BlockCount - 1, Data,
-                                           ElemCount * ElemSize, ElemSize});
+                DeferredExterns.push_back(
+                    {Rec->MetaOffset, MetaEntry->BlockCount - 1, Data,
+                     ElemCount * ElemSize, ElemSize,
+                     WantChecksum ? Rec->ChecksumOffset : (size_t)-1});
             }
             if (Offsets)
                 MetaEntry->Offsets = AppendDims(
                     MetaEntry->Offsets, PreviousDBCount, DimCount, Offsets);
         }
+        if (Rec->ChecksumOffset != (size_t)-1)
+        {
+            size_t *&Checksums = DataChecksums(MetaEntry, Rec->ChecksumOffset);
+            Checksums = (size_t *)realloc(
+                Checksums, MetaEntry->BlockCount * sizeof(size_t));
+            Checksums[MetaEntry->BlockCount - 1] = BlockChecksum;
+            if (Span && WantChecksum)
+            {
+                DeferredSpanChecksums.push_back(
+                    {Rec->MetaOffset, MetaEntry->BlockCount - 1,
+                     Span->bufferIdx, Span->posInBuffer, ElemCount * ElemSize,
+                     Rec->ChecksumOffset});
+            }
+        }
     }
 }
 
@@ -893,6 +1129,7 @@ BufferV *BP5Serializer::ReinitStepData(BufferV *DataBuffer,
     }
     //  Dump data for externs into iovec
     DumpDeferredBlocks(forceCopyDeferred);
+    ChecksumSpans();
 
     m_PriorDataBufferSizeTotal += CurDataBuffer->AddToVec(
         0, NULL, m_BufferBlockSize, true); //  output block size aligned
@@ -969,6 +1206,7 @@ BP5Serializer::TimestepInfo BP5Serializer::CloseTimestep(int timestep,
 
     //  Dump data for externs into iovec
     DumpDeferredBlocks(forceCopyDeferred);
+    ChecksumSpans();
 
     MBase->DataBlockSize = CurDataBuffer->AddToVec(
         0, NULL, m_BufferBlockSize, true); //  output block size aligned
@@ -1007,9 +1245,15 @@ BP5Serializer::TimestepInfo BP5Serializer::CloseTimestep(int timestep,
     MBase->BitField = tmp;
     NewAttribute = false;
 
+    Buffer *MetadataBlock = Metadata;
+    if (m_MetadataKeyframeInterval > 0)
+    {
+        MetadataBlock = EncodeMetadataDelta(Metadata, timestep);
+    }
+
     struct TimestepInfo Ret
     {
-        Formats, Metadata, AttrData, CurDataBuffer
+        Formats, MetadataBlock, AttrData, CurDataBuffer
     };
     CurDataBuffer = NULL;
     if (Info.AttributeFields)
@@ -1023,6 +1267,66 @@ BP5Serializer::TimestepInfo BP5Serializer::CloseTimestep(int timestep,
     return Ret;
 }
 
+Buffer *BP5Serializer::EncodeMetadataDelta(Buffer *Metadata, int timestep)
+{
+    // runs closer than this are merged, a run costs 16 bytes
+    const size_t MinGap = 2 * sizeof(uint64_t);
+    const char *Block = Metadata->Data();
+    const size_t Size = Metadata->m_FixedSize;
+    std::vector<char> Ret;
+    size_t Position = 0;
+    bool Keyframe = m_KeyframeMetadata.empty() ||
+                    (Size != m_KeyframeMetadata.size()) ||
+                    (timestep % m_MetadataKeyframeInterval == 0);
+    if (!Keyframe)
+    {
+        const char *Key = m_KeyframeMetadata.data();
+        MetadataDeltaHeader Header = {MetadataDelta, 0, Size, 0};
+        Ret.resize(sizeof(Header));
+        Position = sizeof(Header);
+        size_t Pos = 0;
+        size_t LastEnd = 0;
+        while (Pos < Size)
+        {
+            if (Block[Pos] == Key[Pos])
+            {
+                Pos++;
+                continue;
+            }
+            size_t End = Pos + 1;
+            size_t Equal = 0;
+            while ((End < Size) && (Equal < MinGap))
+            {
+                Equal = (Block[End] == Key[End]) ? Equal + 1 : 0;
+                End++;
+            }
+            End -= Equal;
+            const uint64_t Run[2] = {Pos - LastEnd, End - Pos};
+            const size_t Padded = (End - Pos + 7) & ~0x7;
+            Ret.resize(Position + sizeof(Run) + Padded);
+            helper::CopyToBuffer(Ret, Position, Run, 2);
+            helper::CopyToBuffer(Ret, Position, Block + Pos, End - Pos);
+            Position = Ret.size();
+            Header.RunCount++;
+            LastEnd = Pos = End;
+        }
+        std::memcpy(Ret.data(), &Header, sizeof(Header));
+        // not worth it, start over from this block
+        Keyframe = (Ret.size() >= Size + sizeof(uint64_t));
+    }
+    if (Keyframe)
+    {
+        const uint64_t Kind = MetadataKeyframe;
+        Ret.resize(sizeof(Kind) + Size);
+        Position = 0;
+        helper::CopyToBuffer(Ret, Position, &Kind);
+        helper::CopyToBuffer(Ret, Position, Block, Size);
+        m_KeyframeMetadata.assign(Block, Block + Size);
+    }
+    delete Metadata;
+    return new BufferSTL(std::move(Ret));
+}
+
 std::vector<char> BP5Serializer::CopyMetadataToContiguous(
     const std::vector<BP5Base::MetaMetaInfoBlock> NewMetaMetaBlocks,
     const format::Buffer *MetaEncodeBuffer,
@@ -1105,14 +1409,16 @@ std::vector<core::iovec> BP5Serializer::BreakoutContiguousMetadata(
     std::vector<char> *Aggregate, const std::vector<size_t> Counts,
     std::vector<MetaMetaInfoBlock> &UniqueMetaMetaBlocks,
     std::vector<core::iovec> &AttributeBlocks, std::vector<uint64_t> &DataSizes,
-    std::vector<uint64_t> &WriterDataPositions) const
+    std::vector<uint64_t> &WriterDataPositions,
+    const std::vector<size_t> *RankOrder) const
 {
     size_t Position = 0;
-    std::vector<core::iovec> MetadataBlocks;
-    MetadataBlocks.reserve(Counts.size());
+    std::vector<core::iovec> MetadataBlocks(Counts.size());
+    AttributeBlocks.resize(Counts.size());
     DataSizes.resize(Counts.size());
-    for (size_t Rank = 0; Rank < Counts.size(); Rank++)
+    for (size_t i = 0; i < Counts.size(); i++)
     {
+        const size_t Rank = RankOrder ? (*RankOrder)[i] : i;
         int32_t NMMBCount;
         helper::CopyFromBuffer(*Aggregate, Position, &NMMBCount);
         for (int i = 0; i < NMMBCount; i++)
@@ -1143,11 +1449,11 @@ std::vector<core::iovec> BP5Serializer::BreakoutContiguousMetadata(
         }
         uint64_t MEBSize;
         helper::CopyFromBuffer(*Aggregate, Position, &MEBSize);
-        MetadataBlocks.push_back({Aggregate->data() + Position, MEBSize});
+        MetadataBlocks[Rank] = {Aggregate->data() + Position, MEBSize};
         Position += MEBSize;
         uint64_t AEBSize;
         helper::CopyFromBuffer(*Aggregate, Position, &AEBSize);
-        AttributeBlocks.push_back({Aggregate->data() + Position, AEBSize});
+        AttributeBlocks[Rank] = {Aggregate->data() + Position, AEBSize};
         Position += AEBSize;
         helper::CopyFromBuffer(*Aggregate, Position, &DataSizes[Rank]);
         helper::CopyFromBuffer(*Aggregate, Position,
@@ -1156,6 +1462,49 @@ std::vector<core::iovec> BP5Serializer::BreakoutContiguousMetadata(
     return MetadataBlocks;
 }
 
+void BP5Serializer::DeduplicateContiguousMetadata(
+    std::vector<char> &Aggregate, std::vector<size_t> &Counts) const
+{
+    std::vector<char> Ret;
+    Ret.reserve(Aggregate.size());
+    std::vector<std::string> SeenIDs;
+    size_t Position = 0;
+    for (size_t Rank = 0; Rank < Counts.size(); Rank++)
+    {
+        const size_t BlockEnd = Position + Counts[Rank];
+        const size_t RetStart = Ret.size();
+        int32_t NMMBCount;
+        helper::CopyFromBuffer(Aggregate, Position, &NMMBCount);
+        int32_t KeptCount = 0;
+        Ret.resize(RetStart + sizeof(KeptCount));
+        for (int i = 0; i < NMMBCount; i++)
+        {
+            const size_t MMBStart = Position;
+            uint64_t IDLen;
+            uint64_t InfoLen;
+            helper::CopyFromBuffer(Aggregate, Position, &IDLen);
+            helper::CopyFromBuffer(Aggregate, Position, &InfoLen);
+            std::string ID(Aggregate.data() + Position, IDLen);
+            Position += IDLen + InfoLen;
+            if (std::find(SeenIDs.begin(), SeenIDs.end(), ID) != SeenIDs.end())
+            {
+                continue;
+            }
+            SeenIDs.push_back(std::move(ID));
+            Ret.insert(Ret.end(), Aggregate.begin() + MMBStart,
+                       Aggregate.begin() + Position);
+            KeptCount++;
+        }
+        std::memcpy(Ret.data() + RetStart, &KeptCount, sizeof(KeptCount));
+        // metadata, attributes, data size and position are kept as is
+        Ret.insert(Ret.end(), Aggregate.begin() + Position,
+                   Aggregate.begin() + BlockEnd);
+        Position = BlockEnd;
+        Counts[Rank] = Ret.size() - RetStart;
+    }
+    Aggregate.swap(Ret);
+}
+
 void *BP5Serializer::GetPtr(int bufferIdx, size_t posInBuffer)
 {
     return CurDataBuffer->GetPtr(bufferIdx, posInBuffer);
@@ -95,12 +95,23 @@ public:
         const format::Buffer *AttributeEncodeBuffer, uint64_t DataSize,
         uint64_t WriterDataPos) const;
 
+    /* RankOrder, if given, is the writer rank of each block in Aggregate,
+     * otherwise the blocks are in rank order */
     std::vector<core::iovec> BreakoutContiguousMetadata(
         std::vector<char> *Aggregate, const std::vector<size_t> Counts,
         std::vector<MetaMetaInfoBlock> &UniqueMetaMetaBlocks,
         std::vector<core::iovec> &AttributeBlocks,
         std::vector<uint64_t> &DataSizes,
-        std::vector<uint64_t> &WriterDataPositions) const;
+        std::vector<uint64_t> &WriterDataPositions,
+        const std::vector<size_t> *RankOrder = nullptr) const;
+
+    /*
+     * Removes the meta-meta blocks of a gathered set of contiguous metadata
+     * blocks that an earlier block in the set already carries.  Aggregate and
+     * Counts are updated in place, the metadata itself is kept as is.
+     */
+    void DeduplicateContiguousMetadata(std::vector<char> &Aggregate,
+                                       std::vector<size_t> &Counts) const;
 
     void *GetPtr(int bufferIdx, size_t posInBuffer);
     size_t CalcSize(const size_t Count, const size_t *Vals);
@@ -109,6 +120,19 @@ public:
 
     int m_StatsLevel = 1;
 
+    /* if > 0, large blocks are divided into sub-blocks of about this many
+     * elements and a Min/Max is recorded for each sub-block */
+    size_t m_StatsBlockSize = 0;
+
+    /* if > 0, metadata blocks are encoded as a difference to the block of
+     * the last keyframe, a keyframe is written at least every this many
+     * steps */
+    size_t m_MetadataKeyframeInterval = 0;
+
+    /* if true, a CRC-32C of every stored array block is recorded in the
+     * metadata, computed while the block is copied into the data buffer */
+    bool m_DataChecksum = false;
+
     /* Variables to help appending to existing file */
     size_t m_PreMetaMetadataFileLength = 0;
 
@@ -129,6 +153,8 @@ private:
         int DimCount;
         int Type;
         size_t MinMaxOffset;
+        size_t SubBlockStatsOffset;
+        size_t ChecksumOffset;
     } * BP5WriterRec;
 
     struct FFSWriterMarshalBase
@@ -153,9 +179,22 @@ private:
         const void *Data;
         size_t DataSize;
         size_t AlignReq;
+        size_t ChecksumOffset;
     };
     std::vector<DeferredExtern> DeferredExterns;
 
+    /* span blocks are only filled by the application after Marshal */
+    struct DeferredSpanChecksum
+    {
+        size_t MetaOffset;
+        size_t BlockID;
+        int BufferIdx;
+        size_t PosInBuffer;
+        size_t DataSize;
+        size_t ChecksumOffset;
+    };
+    std::vector<DeferredSpanChecksum> DeferredSpanChecksums;
+
     FFSWriterMarshalBase Info;
     void *MetadataBuf = NULL;
     bool NewAttribute = false;
@@ -200,6 +239,17 @@ private:
     size_t *AppendDims(size_t *OldDims, const size_t OldCount,
                        const size_t Count, const size_t *Vals);
 
+    void AppendSubBlockStats(BP5WriterRec Rec, MetaArrayRec *MetaEntry,
+                             size_t PreviousDBCount, size_t ElemSize,
+                             const std::vector<size_t> &SubBlockDivs,
+                             const std::vector<char> &SubBlockMinMax);
+    static size_t *&DataChecksums(MetaArrayRec *MetaEntry,
+                                  size_t ChecksumOffset);
+    void ChecksumSpans();
+
+    std::vector<char> m_KeyframeMetadata;
+    Buffer *EncodeMetadataDelta(Buffer *Metadata, int timestep);
+
     void DumpDeferredBlocks(bool forceCopyDeferred = false);
     void VariableStatsEnabled(void *Variable);
 
@@ -17,9 +17,10 @@ namespace format
 {
 
 BufferV::BufferV(const std::string type, const bool AlwaysCopy,
-                 const size_t MemAlign, const size_t MemBlockSize)
+                 const size_t MemAlign, const size_t MemBlockSize,
+                 const unsigned int CopyThreads)
 : m_Type(type), m_MemAlign(MemAlign), m_MemBlockSize(MemBlockSize),
-  m_AlwaysCopy(AlwaysCopy)
+  m_CopyThreads(CopyThreads), m_AlwaysCopy(AlwaysCopy)
 {
 }
 
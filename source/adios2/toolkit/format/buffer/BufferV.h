@@ -24,11 +24,14 @@ public:
     const size_t m_MemAlign; // allocate each pointer aligned
                              // keep each buffer integer multiple of this size
     const size_t m_MemBlockSize;
+    // threads sharing large copies into the buffer, see CopyMemoryThreads
+    const unsigned int m_CopyThreads;
 
     uint64_t Size() noexcept;
 
     BufferV(const std::string type, const bool AlwaysCopy = false,
-            const size_t MemAlign = 1, const size_t MemBlockSize = 1);
+            const size_t MemAlign = 1, const size_t MemBlockSize = 1,
+            const unsigned int CopyThreads = 1);
     virtual ~BufferV();
 
     virtual std::vector<core::iovec> DataVec() noexcept = 0;
@@ -44,9 +47,15 @@ public:
      */
     virtual void Reset();
 
+    /**
+     * Add size bytes at buf to the vector, copying them if CopyReqd.  If
+     * Checksum is not NULL it receives the CRC-32C of the bytes, computed
+     * in the same pass as the copy for host memory.
+     */
     virtual size_t AddToVec(const size_t size, const void *buf, size_t align,
                             bool CopyReqd,
-                            MemorySpace MemSpace = MemorySpace::Host) = 0;
+                            MemorySpace MemSpace = MemorySpace::Host,
+                            uint32_t *Checksum = nullptr) = 0;
 
     struct BufferPos
     {
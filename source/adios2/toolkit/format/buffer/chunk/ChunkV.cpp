@@ -23,8 +23,9 @@ namespace format
 
 ChunkV::ChunkV(const std::string type, const bool AlwaysCopy,
                const size_t MemAlign, const size_t MemBlockSize,
-               const size_t ChunkSize)
-: BufferV(type, AlwaysCopy, MemAlign, MemBlockSize), m_ChunkSize(ChunkSize)
+               const size_t ChunkSize, const unsigned int CopyThreads)
+: BufferV(type, AlwaysCopy, MemAlign, MemBlockSize, CopyThreads),
+  m_ChunkSize(ChunkSize)
 {
 }
 
@@ -94,9 +95,10 @@ void ChunkV::CopyExternalToInternal()
             {
                 // We can use current chunk, just append the data and modify the
                 // DataV entry
-                memcpy(m_TailChunk->Ptr + m_TailChunkPos, DataV[i].Base, size);
+                helper::CopyMemoryThreads(m_TailChunk->Ptr + m_TailChunkPos,
+                                          DataV[i].Base, size, m_CopyThreads);
                 DataV[i].External = false;
-                DataV[i].Base = m_TailChunk + m_TailChunkPos;
+                DataV[i].Base = m_TailChunk->Ptr + m_TailChunkPos;
                 m_TailChunkPos += size;
             }
             else
@@ -109,7 +111,8 @@ void ChunkV::CopyExternalToInternal()
                 ChunkAlloc(c, NewSize);
                 m_Chunks.push_back(c);
                 m_TailChunk = &m_Chunks.back();
-                memcpy(m_TailChunk->Ptr, DataV[i].Base, size);
+                helper::CopyMemoryThreads(m_TailChunk->Ptr, DataV[i].Base, size,
+                                          m_CopyThreads);
                 m_TailChunkPos = size;
                 DataV[i] = {false, m_TailChunk->Ptr, 0, size};
             }
@@ -118,13 +121,18 @@ void ChunkV::CopyExternalToInternal()
 }
 
 size_t ChunkV::AddToVec(const size_t size, const void *buf, size_t align,
-                        bool CopyReqd, MemorySpace MemSpace)
+                        bool CopyReqd, MemorySpace MemSpace,
+                        uint32_t *Checksum)
 {
     AlignBuffer(align); // may call back AddToVec recursively
     size_t retOffset = CurOffset;
 
     if (size == 0)
     {
+        if (Checksum)
+        {
+            *Checksum = 0; // CRC-32C of no bytes
+        }
         return CurOffset;
     }
 
@@ -133,6 +141,10 @@ size_t ChunkV::AddToVec(const size_t size, const void *buf, size_t align,
         // just add buf to internal version of output vector
         VecEntry entry = {true, buf, 0, size};
         DataV.push_back(entry);
+        if (Checksum)
+        {
+            *Checksum = helper::Crc32c(buf, size);
+        }
     }
     else
     {
@@ -163,7 +175,7 @@ size_t ChunkV::AddToVec(const size_t size, const void *buf, size_t align,
         if (AppendPossible)
         {
             // We can use current chunk, just append the data;
-            CopyDataToBuffer(size, buf, m_TailChunkPos, MemSpace);
+            CopyDataToBuffer(size, buf, m_TailChunkPos, MemSpace, Checksum);
             DataV.back().Size += size;
             m_TailChunkPos += size;
         }
@@ -177,7 +189,7 @@ size_t ChunkV::AddToVec(const size_t size, const void *buf, size_t align,
             ChunkAlloc(c, NewSize);
             m_Chunks.push_back(c);
             m_TailChunk = &m_Chunks.back();
-            CopyDataToBuffer(size, buf, 0, MemSpace);
+            CopyDataToBuffer(size, buf, 0, MemSpace, Checksum);
             m_TailChunkPos = size;
             VecEntry entry = {false, m_TailChunk->Ptr, 0, size};
             DataV.push_back(entry);
@@ -188,16 +200,25 @@ size_t ChunkV::AddToVec(const size_t size, const void *buf, size_t align,
 }
 
 void ChunkV::CopyDataToBuffer(const size_t size, const void *buf, size_t pos,
-                              MemorySpace MemSpace)
+                              MemorySpace MemSpace, uint32_t *Checksum)
 {
 #ifdef ADIOS2_HAVE_CUDA
     if (MemSpace == MemorySpace::CUDA)
     {
         helper::CudaMemCopyToBuffer(m_TailChunk->Ptr, pos, buf, size);
+        if (Checksum)
+        {
+            *Checksum = helper::Crc32c(m_TailChunk->Ptr + pos, size);
+        }
         return;
     }
 #endif
-    memcpy(m_TailChunk->Ptr + pos, buf, size);
+    if (Checksum)
+    {
+        *Checksum = helper::CopyWithCrc32c(m_TailChunk->Ptr + pos, buf, size);
+        return;
+    }
+    helper::CopyMemoryThreads(m_TailChunk->Ptr + pos, buf, size, m_CopyThreads);
 }
 
 BufferV::BufferPos ChunkV::Allocate(const size_t size, size_t align)
@@ -27,14 +27,16 @@ public:
 
     ChunkV(const std::string type, const bool AlwaysCopy = false,
            const size_t MemAlign = 1, const size_t MemBlockSize = 1,
-           const size_t ChunkSize = DefaultBufferChunkSize);
+           const size_t ChunkSize = DefaultBufferChunkSize,
+           const unsigned int CopyThreads = 1);
     virtual ~ChunkV();
 
     virtual std::vector<core::iovec> DataVec() noexcept;
 
     virtual size_t AddToVec(const size_t size, const void *buf, size_t align,
                             bool CopyReqd,
-                            MemorySpace MemSpace = MemorySpace::Host);
+                            MemorySpace MemSpace = MemorySpace::Host,
+                            uint32_t *Checksum = nullptr);
 
     virtual BufferPos Allocate(const size_t size, size_t align);
     virtual void DownsizeLastAlloc(const size_t oldSize, const size_t newSize);
@@ -43,7 +45,7 @@ public:
 
     void CopyExternalToInternal();
     void CopyDataToBuffer(const size_t size, const void *buf, size_t pos,
-                          MemorySpace MemSpace);
+                          MemorySpace MemSpace, uint32_t *Checksum = nullptr);
 
 private:
     struct Chunk
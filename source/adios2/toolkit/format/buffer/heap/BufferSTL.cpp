@@ -13,6 +13,7 @@
 #include "adios2/helper/adiosLog.h"
 #include <cstdlib>
 #include <cstring>
+#include <utility>
 
 namespace adios2
 {
@@ -21,6 +22,11 @@ namespace format
 
 BufferSTL::BufferSTL() : Buffer("BufferSTL") {}
 
+BufferSTL::BufferSTL(std::vector<char> &&buffer)
+: Buffer("BufferSTL", buffer.size()), m_Buffer(std::move(buffer))
+{
+}
+
 char *BufferSTL::Data() noexcept { return m_Buffer.data(); }
 
 const char *BufferSTL::Data() const noexcept { return m_Buffer.data(); }
@@ -26,6 +26,8 @@ public:
     std::vector<char> m_Buffer;
 
     BufferSTL();
+    // fixed size buffer holding the given content
+    explicit BufferSTL(std::vector<char> &&buffer);
     ~BufferSTL() = default;
 
     char *Data() noexcept final;
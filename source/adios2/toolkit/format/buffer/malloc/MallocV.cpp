@@ -7,6 +7,7 @@
  */
 
 #include "MallocV.h"
+#include "adios2/helper/adiosFunctions.h"
 #include "adios2/toolkit/format/buffer/BufferV.h"
 
 #include <algorithm>
@@ -21,8 +22,9 @@ namespace format
 
 MallocV::MallocV(const std::string type, const bool AlwaysCopy,
                  const size_t MemAlign, const size_t MemBlockSize,
-                 size_t InitialBufferSize, double GrowthFactor)
-: BufferV(type, AlwaysCopy, MemAlign, MemBlockSize),
+                 size_t InitialBufferSize, double GrowthFactor,
+                 const unsigned int CopyThreads)
+: BufferV(type, AlwaysCopy, MemAlign, MemBlockSize, CopyThreads),
   m_InitialBufferSize(InitialBufferSize), m_GrowthFactor(GrowthFactor)
 {
 }
@@ -76,7 +78,8 @@ void MallocV::CopyExternalToInternal()
                 m_InternalBlock = (char *)realloc(m_InternalBlock, NewSize);
                 m_AllocatedSize = NewSize;
             }
-            memcpy(m_InternalBlock + m_internalPos, DataV[i].Base, size);
+            helper::CopyMemoryThreads(m_InternalBlock + m_internalPos,
+                                      DataV[i].Base, size, m_CopyThreads);
             DataV[i].External = false;
             DataV[i].Base = NULL;
             DataV[i].Offset = m_internalPos;
@@ -86,13 +89,18 @@ void MallocV::CopyExternalToInternal()
 }
 
 size_t MallocV::AddToVec(const size_t size, const void *buf, size_t align,
-                         bool CopyReqd, MemorySpace MemSpace)
+                         bool CopyReqd, MemorySpace MemSpace,
+                         uint32_t *Checksum)
 {
     AlignBuffer(align); // may call back AddToVec recursively
     size_t retOffset = CurOffset;
 
     if (size == 0)
     {
+        if (Checksum)
+        {
+            *Checksum = 0; // CRC-32C of no bytes
+        }
         return CurOffset;
     }
 
@@ -101,6 +109,10 @@ size_t MallocV::AddToVec(const size_t size, const void *buf, size_t align,
         // just add buf to internal version of output vector
         VecEntry entry = {true, buf, 0, size};
         DataV.push_back(entry);
+        if (Checksum)
+        {
+            *Checksum = helper::Crc32c(buf, size);
+        }
     }
     else
     {
@@ -120,7 +132,16 @@ size_t MallocV::AddToVec(const size_t size, const void *buf, size_t align,
             m_InternalBlock = (char *)realloc(m_InternalBlock, NewSize);
             m_AllocatedSize = NewSize;
         }
-        memcpy(m_InternalBlock + m_internalPos, buf, size);
+        if (Checksum)
+        {
+            *Checksum = helper::CopyWithCrc32c(m_InternalBlock + m_internalPos,
+                                               buf, size);
+        }
+        else
+        {
+            helper::CopyMemoryThreads(m_InternalBlock + m_internalPos, buf,
+                                      size, m_CopyThreads);
+        }
 
         if (DataV.size() && !DataV.back().External &&
             (m_internalPos == (DataV.back().Offset + DataV.back().Size)))
@@ -26,7 +26,8 @@ public:
     MallocV(const std::string type, const bool AlwaysCopy = false,
             const size_t MemAlign = 1, const size_t MemBlockSize = 1,
             size_t InitialBufferSize = DefaultInitialBufferSize,
-            double GrowthFactor = DefaultBufferGrowthFactor);
+            double GrowthFactor = DefaultBufferGrowthFactor,
+            const unsigned int CopyThreads = 1);
     virtual ~MallocV();
 
     virtual std::vector<core::iovec> DataVec() noexcept;
@@ -38,7 +39,8 @@ public:
 
     virtual size_t AddToVec(const size_t size, const void *buf, size_t align,
                             bool CopyReqd,
-                            MemorySpace MemSpace = MemorySpace::Host);
+                            MemorySpace MemSpace = MemorySpace::Host,
+                            uint32_t *Checksum = nullptr);
 
     virtual BufferPos Allocate(const size_t size, size_t align);
     void DownsizeLastAlloc(const size_t oldSize, const size_t newSize);
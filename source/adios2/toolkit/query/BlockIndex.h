@@ -1,6 +1,8 @@
 #ifndef ADIOS2_BLOCK_INDEX_H
 #define ADIOS2_BLOCK_INDEX_H
 
+#include <mutex>
+
 #include "Index.h"
 #include "Query.h"
 
@@ -9,6 +11,17 @@ namespace adios2
 namespace query
 {
 
+/**
+ * Engines do not promise thread-safe metadata lookups, concurrent evaluations
+ * (see Worker::GetResultCoverage over a step range) take turns on the engine
+ * and only check the statistics in parallel.
+ */
+inline std::mutex &EngineMetadataMutex()
+{
+    static std::mutex engineMutex;
+    return engineMutex;
+}
+
 template <class T>
 class BlockIndex
 {
@@ -30,23 +43,123 @@ public:
 
     void Generate(std::string &fromBPFile, const adios2::Params &inputs) {}
 
-    void Evaluate(const QueryVar &query,
+    /**
+     * Sub-block i of a block, in global coordinates like the query
+     * selection. helper::GetSubBlock returns it relative to the block.
+     */
+    static adios2::Box<adios2::Dims>
+    GlobalSubBlock(const adios2::Dims &blockStart,
+                   const adios2::Dims &blockCount,
+                   const helper::BlockDivisionInfo &subBlockInfo,
+                   const unsigned int i)
+    {
+        adios2::Box<adios2::Dims> subBlock =
+            adios2::helper::GetSubBlock(blockCount, subBlockInfo, i);
+        for (size_t d = 0; d < blockStart.size(); d++)
+            subBlock.first[d] += blockStart[d];
+        return subBlock;
+    }
+
+    void Evaluate(const QueryVar &query, const size_t step,
                   std::vector<adios2::Box<adios2::Dims>> &resultSubBlocks)
     {
-        RunBP4Stat(query, resultSubBlocks);
+        MinVarInfo *minBlocksInfo = nullptr;
+        std::vector<typename adios2::core::Variable<T>::BPInfo> varBlocksInfo;
+        adios2::Dims currShape;
+        {
+            std::lock_guard<std::mutex> lock(EngineMetadataMutex());
+            // the shape of the evaluated step, not of the current one
+            const adios2::Dims *stepShape = m_IdxReader.VarShape(m_Var, step);
+            if (stepShape)
+            {
+                currShape = *stepShape;
+            }
+            else
+            {
+                auto it = m_Var.m_AvailableShapes.find(step + 1);
+                currShape = (it != m_Var.m_AvailableShapes.end())
+                                ? it->second
+                                : m_Var.m_Shape;
+            }
+            // engines with min blocks info (BP5, SST) don't fill BlocksInfo()
+            minBlocksInfo = m_IdxReader.MinBlocksInfo(m_Var, step);
+            if (!minBlocksInfo)
+                varBlocksInfo = m_IdxReader.BlocksInfo(m_Var, step);
+        }
+
+        if (!query.IsSelectionValid(currShape))
+        {
+            delete minBlocksInfo;
+            return;
+        }
+
+        if (minBlocksInfo)
+        {
+            RunBP5Stat(query, *minBlocksInfo, resultSubBlocks);
+            delete minBlocksInfo;
+            return;
+        }
+        RunBP4Stat(query, varBlocksInfo, resultSubBlocks);
     }
 
-    void RunBP4Stat(const QueryVar &query,
+    void RunBP5Stat(const QueryVar &query, const MinVarInfo &minBlocksInfo,
                     std::vector<adios2::Box<adios2::Dims>> &hitBlocks)
     {
-        size_t currStep = m_IdxReader.CurrentStep();
-        adios2::Dims currShape = m_Var.Shape();
-        if (!query.IsSelectionValid(currShape))
+        if (minBlocksInfo.IsValue || minBlocksInfo.WasLocalVar)
             return;
 
-        std::vector<typename adios2::core::Variable<T>::BPInfo> varBlocksInfo =
-            m_IdxReader.BlocksInfo(m_Var, currStep);
+        const size_t ndim = static_cast<size_t>(minBlocksInfo.Dims);
+        for (auto &blockInfo : minBlocksInfo.BlocksInfo)
+        {
+            adios2::Dims start(ndim, 0);
+            adios2::Dims count(blockInfo.Count, blockInfo.Count + ndim);
+            if (blockInfo.Start)
+                start.assign(blockInfo.Start, blockInfo.Start + ndim);
+
+            if (!query.TouchSelection(start, count))
+                continue;
+
+            if (blockInfo.SubBlockCount > 1)
+            {
+                helper::BlockDivisionInfo subBlockInfo;
+                subBlockInfo.Div.assign(blockInfo.SubBlockDivs,
+                                        blockInfo.SubBlockDivs + ndim);
+                adios2::helper::CalculateSubblockInfo(count, subBlockInfo);
+                const T *minMaxs =
+                    static_cast<const T *>(blockInfo.SubBlockMinMax);
+                for (unsigned int i = 0; i < subBlockInfo.NBlocks; i++)
+                {
+                    T min = minMaxs[2 * i];
+                    T max = minMaxs[2 * i + 1];
+                    if (!query.m_RangeTree.CheckInterval(min, max))
+                        continue;
+
+                    adios2::Box<adios2::Dims> currSubBlock =
+                        GlobalSubBlock(start, count, subBlockInfo, i);
+                    if (!query.TouchSelection(currSubBlock.first,
+                                              currSubBlock.second))
+                        continue;
+                    hitBlocks.push_back(currSubBlock);
+                }
+            }
+            else
+            {
+                T min = *reinterpret_cast<const T *>(&blockInfo.MinMax.MinUnion);
+                T max = *reinterpret_cast<const T *>(&blockInfo.MinMax.MaxUnion);
+                if (query.m_RangeTree.CheckInterval(min, max))
+                {
+                    adios2::Box<adios2::Dims> box = {start, count};
+                    hitBlocks.push_back(box);
+                }
+            }
+        }
+    }
 
+    void RunBP4Stat(
+        const QueryVar &query,
+        std::vector<typename adios2::core::Variable<T>::BPInfo> &varBlocksInfo,
+        std::vector<adios2::Box<adios2::Dims>> &hitBlocks)
+    {
         for (auto &blockInfo : varBlocksInfo)
         {
             if (!query.TouchSelection(blockInfo.Start, blockInfo.Count))
@@ -65,8 +178,8 @@ public:
                     if (isHit)
                     {
                         adios2::Box<adios2::Dims> currSubBlock =
-                            adios2::helper::GetSubBlock(
-                                blockInfo.Count, blockInfo.SubBlockInfo, i);
+                            GlobalSubBlock(blockInfo.Start, blockInfo.Count,
+                                           blockInfo.SubBlockInfo, i);
                         if (!query.TouchSelection(currSubBlock.first,
                                                   currSubBlock.second))
                             continue;
@@ -121,7 +234,8 @@ public:
     */
 
     Tree m_Content;
-    adios2::core::Variable<T> m_Var;
+    // engines look up their per-variable metadata by address, keep a reference
+    adios2::core::Variable<T> &m_Var;
 
 private:
     //
@@ -2,6 +2,9 @@
 #include "BlockIndex.h"
 #include "adios2/helper/adiosFunctions.h"
 
+#include <algorithm>   // std::fill
+#include <type_traits> // std::integral_constant
+
 #include "Query.tcc"
 
 namespace adios2
@@ -99,6 +102,7 @@ bool QueryComposite::AddNode(QueryBase *var)
 
 void QueryComposite::BlockIndexEvaluate(adios2::core::IO &io,
                                         adios2::core::Engine &reader,
+                                        const size_t step,
                                         std::vector<Box<Dims>> &touchedBlocks)
 {
     auto lf_ApplyAND = [&](std::vector<Box<Dims>> &touched,
@@ -206,7 +210,7 @@ void QueryComposite::BlockIndexEvaluate(adios2::core::IO &io,
     {
         counter++;
         std::vector<Box<Dims>> currBlocks;
-        node->BlockIndexEvaluate(io, reader, currBlocks);
+        node->BlockIndexEvaluate(io, reader, step, currBlocks);
         if (counter == 1)
         {
             touchedBlocks = currBlocks;
@@ -234,6 +238,42 @@ void QueryComposite::BlockIndexEvaluate(adios2::core::IO &io,
     // from BP3
 }
 
+void QueryComposite::ElementEvaluate(adios2::core::IO &io,
+                                     adios2::core::Engine &reader,
+                                     const std::vector<Box<Dims>> &boxes,
+                                     std::vector<std::vector<char>> &masks)
+{
+    masks.clear();
+    if (m_Nodes.size() == 0)
+        return;
+
+    std::vector<std::vector<char>> curr;
+    for (size_t k = 0; k < m_Nodes.size(); k++)
+    {
+        if (k == 0)
+        {
+            m_Nodes[k]->ElementEvaluate(io, reader, boxes, masks);
+            continue;
+        }
+        m_Nodes[k]->ElementEvaluate(io, reader, boxes, curr);
+        for (size_t b = 0; b < masks.size() && b < curr.size(); b++)
+        {
+            std::vector<char> &mask = masks[b];
+            const size_t n = std::min(mask.size(), curr[b].size());
+            if (adios2::query::Relation::AND == m_Relation)
+            {
+                for (size_t i = 0; i < n; i++)
+                    mask[i] &= curr[b][i];
+            }
+            else if (adios2::query::Relation::OR == m_Relation)
+            {
+                for (size_t i = 0; i < n; i++)
+                    mask[i] |= curr[b][i];
+            }
+        }
+    }
+}
+
 bool QueryVar::IsSelectionValid(adios2::Dims &shape) const
 {
     if (0 == m_Selection.first.size())
@@ -304,20 +344,22 @@ bool QueryVar::TouchSelection(adios2::Dims &start, adios2::Dims &count) const
 
 void QueryVar::BlockIndexEvaluate(adios2::core::IO &io,
                                   adios2::core::Engine &reader,
+                                  const size_t step,
                                   std::vector<Box<Dims>> &touchedBlocks)
 {
+    // evaluations of several steps run concurrently, the IO lookups take
+    // turns like the engine metadata lookups
+    std::unique_lock<std::mutex> lock(EngineMetadataMutex());
     const DataType varType = io.InquireVariableType(m_VarName);
 
-    // Variable<int> var = io.InquireVariable<int>(m_VarName);
-    // BlockIndex<int> idx(io, reader);
-
     // var already exists when loading query. skipping validity checking
 #define declare_type(T)                                                        \
     if (varType == adios2::helper::GetDataType<T>())                           \
     {                                                                          \
         core::Variable<T> *var = io.InquireVariable<T>(m_VarName);             \
+        lock.unlock();                                                         \
         BlockIndex<T> idx(*var, io, reader);                                   \
-        idx.Evaluate(*this, touchedBlocks);                                    \
+        idx.Evaluate(*this, step, touchedBlocks);                              \
     }
     // ADIOS2_FOREACH_ATTRIBUTE_TYPE_1ARG(declare_type) //skip complex types
     ADIOS2_FOREACH_ATTRIBUTE_PRIMITIVE_STDTYPE_1ARG(declare_type)
@@ -329,5 +371,32 @@ void QueryVar::BlockIndexEvaluate(adios2::core::IO &io,
         ApplyOutputRegion(touchedBlocks, m_Selection);
     }
 }
+
+void QueryVar::ElementEvaluate(adios2::core::IO &io,
+                               adios2::core::Engine &reader,
+                               const std::vector<Box<Dims>> &boxes,
+                               std::vector<std::vector<char>> &masks)
+{
+    masks.clear();
+    const DataType varType = io.InquireVariableType(m_VarName);
+
+#define declare_type(T)                                                        \
+    if (varType == adios2::helper::GetDataType<T>())                           \
+    {                                                                          \
+        std::vector<std::vector<T>> data;                                      \
+        ReadAndCheck(io, reader, boxes, data, masks);                          \
+    }
+    ADIOS2_FOREACH_ATTRIBUTE_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+}
+
+#define declare_template_instantiation(T)                                      \
+    template void QueryVar::ReadAndCheck(                                      \
+        adios2::core::IO &, adios2::core::Engine &,                            \
+        const std::vector<Box<Dims>> &, std::vector<std::vector<T>> &,         \
+        std::vector<std::vector<char>> &);
+ADIOS2_FOREACH_ATTRIBUTE_PRIMITIVE_STDTYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+
 } // namespace query
 } // namespace adios2
@@ -41,6 +41,39 @@ adios2::query::Op strToQueryOp(std::string opStr) noexcept;
 
 adios2::Dims split(const std::string &s, char delim);
 
+/**
+ * Restores the selection of a variable when going out of scope, so that
+ * reads on behalf of a query leave the user's selection as it was.
+ */
+class SelectionGuard
+{
+public:
+    explicit SelectionGuard(core::VariableBase &variable)
+    : m_Variable(variable), m_Start(variable.m_Start),
+      m_Count(variable.m_Count), m_SelectionType(variable.m_SelectionType),
+      m_BlockID(variable.m_BlockID)
+    {
+    }
+
+    ~SelectionGuard()
+    {
+        m_Variable.m_Start = m_Start;
+        m_Variable.m_Count = m_Count;
+        m_Variable.m_SelectionType = m_SelectionType;
+        m_Variable.m_BlockID = m_BlockID;
+    }
+
+    SelectionGuard(const SelectionGuard &) = delete;
+    SelectionGuard &operator=(const SelectionGuard &) = delete;
+
+private:
+    core::VariableBase &m_Variable;
+    const Dims m_Start;
+    const Dims m_Count;
+    const SelectionType m_SelectionType;
+    const size_t m_BlockID;
+};
+
 //
 // classes
 //
@@ -56,6 +89,11 @@ public:
     template <class T>
     bool CheckInterval(T &min, T &max) const;
 
+    /** mask[i] = 1 if data[i] is in the range, 0 otherwise */
+    template <class T>
+    void CheckValues(const T *data, const size_t n,
+                     std::vector<char> &mask) const;
+
     void Print() { std::cout << "===> " << m_StrValue << std::endl; }
 }; // class Range
 
@@ -88,6 +126,10 @@ public:
     template <class T>
     bool CheckInterval(T &min, T &max) const;
 
+    template <class T>
+    void CheckValues(const T *data, const size_t n,
+                     std::vector<char> &mask) const;
+
     adios2::query::Relation m_Relation = adios2::query::Relation::AND;
     std::vector<Range> m_Leaves;
     std::vector<RangeTree> m_SubNodes;
@@ -99,9 +141,21 @@ public:
     virtual ~QueryBase(){};
     virtual bool IsCompatible(const adios2::Box<adios2::Dims> &box) = 0;
     virtual void Print() = 0;
+    /** evaluates the query on the block statistics of an (absolute) step */
     virtual void BlockIndexEvaluate(adios2::core::IO &, adios2::core::Engine &,
+                                    const size_t step,
                                     std::vector<Box<Dims>> &touchedBlocks) = 0;
 
+    /**
+     * reads boxes (global coordinates) of the current step with deferred
+     * Gets and a single PerformGets, and checks every element.
+     * masks[b][i] is set for the matching elements of boxes[b] in row-major
+     * order
+     */
+    virtual void ElementEvaluate(adios2::core::IO &, adios2::core::Engine &,
+                                 const std::vector<Box<Dims>> &boxes,
+                                 std::vector<std::vector<char>> &masks) = 0;
+
     Box<Dims> GetIntersection(const Box<Dims> &box1,
                               const Box<Dims> &box2) noexcept
     {
@@ -142,7 +196,19 @@ public:
 
     std::string &GetVarName() { return m_VarName; }
     void BlockIndexEvaluate(adios2::core::IO &, adios2::core::Engine &,
+                            const size_t step,
                             std::vector<Box<Dims>> &touchedBlocks);
+    void ElementEvaluate(adios2::core::IO &, adios2::core::Engine &,
+                         const std::vector<Box<Dims>> &boxes,
+                         std::vector<std::vector<char>> &masks);
+
+    /** ElementEvaluate that also hands back the values read */
+    template <class T>
+    void ReadAndCheck(adios2::core::IO &io, adios2::core::Engine &reader,
+                      const std::vector<Box<Dims>> &boxes,
+                      std::vector<std::vector<T>> &data,
+                      std::vector<std::vector<char>> &masks);
+
     void BroadcastOutputRegion(const adios2::Box<adios2::Dims> &region)
     {
         m_OutputRegion = region;
@@ -218,7 +284,11 @@ public:
     }
 
     void BlockIndexEvaluate(adios2::core::IO &, adios2::core::Engine &,
+                            const size_t step,
                             std::vector<Box<Dims>> &touchedBlocks);
+    void ElementEvaluate(adios2::core::IO &, adios2::core::Engine &,
+                         const std::vector<Box<Dims>> &boxes,
+                         std::vector<std::vector<char>> &masks);
 
     bool AddNode(QueryBase *v);
 
@@ -3,13 +3,39 @@ namespace adios2
 namespace query
 {
 
+template <class T>
+T RangeValue(const std::string &str, std::false_type /*isByte*/)
+{
+    std::stringstream convert(str);
+    T value = T();
+    convert >> value;
+    return value;
+}
+
+template <class T>
+T RangeValue(const std::string &str, std::true_type /*isByte*/)
+{
+    // streaming into a char type reads a character, not a number
+    std::stringstream convert(str);
+    int value = 0;
+    convert >> value;
+    return static_cast<T>(value);
+}
+
+/** the value of a range for comparisons with T */
+template <class T>
+T RangeValue(const std::string &str)
+{
+    return RangeValue<T>(
+        str, std::integral_constant<bool, std::is_integral<T>::value &&
+                                              sizeof(T) == 1>());
+}
+
 template <class T>
 bool Range::CheckInterval(T &min, T &max) const
 {
     bool isHit = false;
-    std::stringstream convert(m_StrValue);
-    T value;
-    convert >> value;
+    const T value = RangeValue<T>(m_StrValue);
 
     switch (m_Op)
     {
@@ -37,6 +63,120 @@ bool Range::CheckInterval(T &min, T &max) const
     return isHit;
 }
 
+template <class T>
+void Range::CheckValues(const T *data, const size_t n,
+                        std::vector<char> &mask) const
+{
+    const T value = RangeValue<T>(m_StrValue);
+
+    mask.resize(n);
+    char *hit = mask.data();
+    // one plain loop per operator, these vectorize
+    switch (m_Op)
+    {
+    case adios2::query::Op::GT:
+        for (size_t i = 0; i < n; i++)
+            hit[i] = (data[i] > value);
+        break;
+    case adios2::query::Op::LT:
+        for (size_t i = 0; i < n; i++)
+            hit[i] = (data[i] < value);
+        break;
+    case adios2::query::Op::GE:
+        for (size_t i = 0; i < n; i++)
+            hit[i] = (data[i] >= value);
+        break;
+    case adios2::query::Op::LE:
+        for (size_t i = 0; i < n; i++)
+            hit[i] = (data[i] <= value);
+        break;
+    case adios2::query::Op::EQ:
+        for (size_t i = 0; i < n; i++)
+            hit[i] = (data[i] == value);
+        break;
+    case adios2::query::Op::NE:
+        for (size_t i = 0; i < n; i++)
+            hit[i] = (data[i] != value);
+        break;
+    default:
+        std::fill(mask.begin(), mask.end(), 0);
+        break;
+    }
+}
+
+template <class T>
+void RangeTree::CheckValues(const T *data, const size_t n,
+                            std::vector<char> &mask) const
+{
+    const bool isAND = (adios2::query::Relation::AND == m_Relation);
+    if (!isAND && (adios2::query::Relation::OR != m_Relation))
+    {
+        // anything else are false
+        mask.assign(n, 0);
+        return;
+    }
+
+    // AND starts with all hits (even if no leaves or nodes), OR with none
+    mask.assign(n, isAND ? 1 : 0);
+    std::vector<char> curr;
+    auto lf_Combine = [&]() {
+        char *hit = mask.data();
+        const char *currHit = curr.data();
+        if (isAND)
+            for (size_t i = 0; i < n; i++)
+                hit[i] &= currHit[i];
+        else
+            for (size_t i = 0; i < n; i++)
+                hit[i] |= currHit[i];
+    };
+
+    for (auto &range : m_Leaves)
+    {
+        range.CheckValues(data, n, curr);
+        lf_Combine();
+    }
+    for (auto &node : m_SubNodes)
+    {
+        node.CheckValues(data, n, curr);
+        lf_Combine();
+    }
+}
+
+template <class T>
+void QueryVar::ReadAndCheck(adios2::core::IO &io, adios2::core::Engine &reader,
+                            const std::vector<Box<Dims>> &boxes,
+                            std::vector<std::vector<T>> &data,
+                            std::vector<std::vector<char>> &masks)
+{
+    core::Variable<T> *var = io.InquireVariable<T>(m_VarName);
+    if (var == nullptr)
+    {
+        helper::Throw<std::invalid_argument>(
+            "Toolkit", "query::QueryVar", "ReadAndCheck",
+            "variable " + m_VarName + " of the query not found");
+    }
+
+    data.resize(boxes.size());
+    {
+        // deferred Gets keep the selection they were issued with, the
+        // user's selection is restored afterwards
+        SelectionGuard guard(*var);
+        for (size_t b = 0; b < boxes.size(); b++)
+        {
+            var->SetSelection(boxes[b]);
+            data[b].resize(helper::GetTotalSize(boxes[b].second));
+            reader.Get(*var, data[b].data(), adios2::Mode::Deferred);
+        }
+    }
+    reader.PerformGets();
+
+    masks.resize(boxes.size());
+    for (size_t b = 0; b < boxes.size(); b++)
+    {
+        m_RangeTree.CheckValues(data[b].data(), data[b].size(), masks[b]);
+    }
+}
+
 template <class T>
 bool RangeTree::CheckInterval(T &min, T &max) const
 {
@@ -1,6 +1,12 @@
 #include "Worker.h"
 #include "adios2/helper/adiosFunctions.h"
 
+#include <algorithm> // std::min
+#include <atomic>
+#include <exception> // std::exception_ptr
+#include <mutex>
+#include <thread>
+
 namespace adios2
 {
 namespace query
@@ -109,8 +115,347 @@ void Worker::GetResultCoverage(const adios2::Box<adios2::Dims> &outputRegion,
     if (m_Query && m_SourceReader)
     {
         m_Query->BlockIndexEvaluate(m_SourceReader->m_IO, *m_SourceReader,
+                                    m_SourceReader->CurrentStep(),
                                     touchedBlocks);
     }
 }
+
+void Worker::GetResultCoverage(
+    const adios2::Box<adios2::Dims> &outputRegion, const size_t firstStep,
+    const size_t nSteps, std::vector<std::vector<Box<Dims>>> &touchedBlocks,
+    const unsigned int nThreads)
+{
+    touchedBlocks.clear();
+
+    if (!m_Query || !m_SourceReader)
+        return;
+
+    // in streaming mode engines only hold the metadata of the current step
+    const Mode openMode = m_SourceReader->OpenMode();
+    const std::string &engineType = m_SourceReader->m_EngineType;
+    const bool isRandomAccess =
+        (openMode == Mode::ReadRandomAccess) ||
+        ((openMode == Mode::Read) && !m_SourceReader->m_IO.m_ReadStreaming &&
+         ((engineType == "BP3") || (engineType == "BP4Reader")));
+    if (!isRandomAccess)
+    {
+        helper::Throw<std::invalid_argument>(
+            "Toolkit", "query::Worker", "GetResultCoverage",
+            "evaluating a range of steps requires a reader opened for random "
+            "access (ReadRandomAccess for BP5, Read without BeginStep for "
+            "BP3/BP4)");
+    }
+
+    if (!m_Query->UseOutputRegion(outputRegion))
+    {
+        helper::Throw<std::invalid_argument>("Toolkit", "query::Worker",
+                                             "GetResultCoverage",
+                                             "Unable to use the output region");
+    }
+
+    const size_t availableSteps = m_SourceReader->Steps();
+    if (firstStep >= availableSteps)
+        return;
+    const size_t stepCount = std::min(nSteps, availableSteps - firstStep);
+    touchedBlocks.resize(stepCount);
+
+    const helper::Comm &comm = m_SourceReader->GetComm();
+    const size_t rank = static_cast<size_t>(comm.Rank());
+    const size_t size = static_cast<size_t>(comm.Size());
+
+    std::vector<size_t> myIndices;
+    for (size_t i = rank; i < stepCount; i += size)
+        myIndices.push_back(i);
+
+    std::atomic<size_t> next(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto lf_Evaluate = [&]() {
+        for (size_t n = next++; n < myIndices.size(); n = next++)
+        {
+            const size_t i = myIndices[n];
+            try
+            {
+                m_Query->BlockIndexEvaluate(m_SourceReader->m_IO,
+                                            *m_SourceReader, firstStep + i,
+                                            touchedBlocks[i]);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+    };
+
+    const size_t nWorkers =
+        std::min(static_cast<size_t>(std::max(nThreads, 1u)), myIndices.size());
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < nWorkers; ++t)
+        workers.emplace_back(lf_Evaluate);
+    lf_Evaluate();
+    for (auto &w : workers)
+        w.join();
+
+    // agree on failures first, a failed rank must not leave the others
+    // waiting in the exchange
+    if (size > 1)
+    {
+        const int failed = error ? 1 : 0;
+        int anyFailed = 0;
+        comm.Allreduce(&failed, &anyFailed, 1, helper::Comm::Op::Max,
+                       "in query::Worker::GetResultCoverage");
+        if (anyFailed && !error)
+        {
+            helper::Throw<std::runtime_error>(
+                "Toolkit", "query::Worker", "GetResultCoverage",
+                "query evaluation failed on another rank");
+        }
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+
+    if (size > 1)
+        ExchangeCoverage(comm, myIndices, touchedBlocks);
+}
+
+namespace
+{
+
+/**
+ * Uses the full extent of the variables while reading elements, and puts
+ * the output region set by the caller back when going out of scope.
+ */
+class GlobalRegionGuard
+{
+public:
+    explicit GlobalRegionGuard(QueryBase &query)
+    : m_Query(query), m_OutputRegion(query.m_OutputRegion)
+    {
+        m_Query.UseOutputRegion(adios2::Box<Dims>());
+    }
+
+    ~GlobalRegionGuard() { m_Query.UseOutputRegion(m_OutputRegion); }
+
+    GlobalRegionGuard(const GlobalRegionGuard &) = delete;
+    GlobalRegionGuard &operator=(const GlobalRegionGuard &) = delete;
+
+private:
+    QueryBase &m_Query;
+    const adios2::Box<Dims> m_OutputRegion;
+};
+
+/** appends the parts of box (start, count) outside of cut to pieces */
+void SubtractBox(Box<Dims> box, const Box<Dims> &cut,
+                 std::vector<Box<Dims>> &pieces)
+{
+    const size_t nDims = box.first.size();
+    for (size_t d = 0; d < nDims; d++)
+    {
+        const size_t boxEnd = box.first[d] + box.second[d];
+        const size_t cutEnd = cut.first[d] + cut.second[d];
+        if (cutEnd <= box.first[d] || boxEnd <= cut.first[d])
+        {
+            // disjoint
+            pieces.push_back(box);
+            return;
+        }
+    }
+
+    for (size_t d = 0; d < nDims; d++)
+    {
+        const size_t boxEnd = box.first[d] + box.second[d];
+        const size_t cutEnd = cut.first[d] + cut.second[d];
+        if (box.first[d] < cut.first[d])
+        {
+            Box<Dims> below = box;
+            below.second[d] = cut.first[d] - box.first[d];
+            pieces.push_back(below);
+            box.second[d] -= below.second[d];
+            box.first[d] = cut.first[d];
+        }
+        if (cutEnd < boxEnd)
+        {
+            Box<Dims> above = box;
+            above.first[d] = cutEnd;
+            above.second[d] = boxEnd - cutEnd;
+            pieces.push_back(above);
+            box.second[d] -= above.second[d];
+        }
+    }
+    // what is left of box lies inside cut
+}
+
+/**
+ * Clips the boxes so that no element is covered twice, candidates of a
+ * composite query can partially overlap.
+ */
+std::vector<Box<Dims>> MakeDisjoint(const std::vector<Box<Dims>> &boxes)
+{
+    std::vector<Box<Dims>> disjoint;
+    std::vector<Box<Dims>> pieces, clipped;
+    for (const auto &box : boxes)
+    {
+        if (helper::GetTotalSize(box.second) == 0)
+            continue;
+        pieces.assign(1, box);
+        for (const auto &done : disjoint)
+        {
+            clipped.clear();
+            for (const auto &piece : pieces)
+                SubtractBox(piece, done, clipped);
+            pieces.swap(clipped);
+            if (pieces.empty())
+                break;
+        }
+        disjoint.insert(disjoint.end(), pieces.begin(), pieces.end());
+    }
+    return disjoint;
+}
+
+} // end empty namespace
+
+void Worker::GetResultHits(std::vector<Box<Dims>> &touchedBlocks,
+                           std::vector<std::vector<size_t>> &hits)
+{
+    touchedBlocks.clear();
+    hits.clear();
+
+    if (!m_Query || !m_SourceReader)
+        return;
+
+    // boxes are read from the file, keep them in global coordinates
+    GlobalRegionGuard regionGuard(*m_Query);
+
+    std::vector<Box<Dims>> candidates;
+    m_Query->BlockIndexEvaluate(m_SourceReader->m_IO, *m_SourceReader,
+                                m_SourceReader->CurrentStep(), candidates);
+    candidates = MakeDisjoint(candidates);
+
+    std::vector<std::vector<char>> masks;
+    m_Query->ElementEvaluate(m_SourceReader->m_IO, *m_SourceReader,
+                             candidates, masks);
+    for (size_t b = 0; b < masks.size(); b++)
+    {
+        const std::vector<char> &mask = masks[b];
+        std::vector<size_t> boxHits;
+        for (size_t i = 0; i < mask.size(); i++)
+            if (mask[i])
+                boxHits.push_back(i);
+        if (boxHits.empty())
+            continue;
+        touchedBlocks.push_back(candidates[b]);
+        hits.push_back(std::move(boxHits));
+    }
+}
+
+template <class T>
+void Worker::GetResultValues(std::vector<Box<Dims>> &touchedBlocks,
+                             std::vector<std::vector<size_t>> &hits,
+                             std::vector<T> &values)
+{
+    touchedBlocks.clear();
+    hits.clear();
+    values.clear();
+
+    if (!m_Query || !m_SourceReader)
+        return;
+
+    QueryVar *varQuery = dynamic_cast<QueryVar *>(m_Query);
+    if ((varQuery == nullptr) ||
+        (m_SourceReader->m_IO.InquireVariableType(varQuery->GetVarName()) !=
+         helper::GetDataType<T>()))
+    {
+        helper::Throw<std::invalid_argument>(
+            "Toolkit", "query::Worker", "GetResultValues",
+            "values are only available for a query on a single variable of "
+            "the requested type");
+    }
+
+    // boxes are read from the file, keep them in global coordinates
+    GlobalRegionGuard regionGuard(*m_Query);
+
+    std::vector<Box<Dims>> candidates;
+    m_Query->BlockIndexEvaluate(m_SourceReader->m_IO, *m_SourceReader,
+                                m_SourceReader->CurrentStep(), candidates);
+    candidates = MakeDisjoint(candidates);
+
+    std::vector<std::vector<T>> data;
+    std::vector<std::vector<char>> masks;
+    varQuery->ReadAndCheck(m_SourceReader->m_IO, *m_SourceReader, candidates,
+                           data, masks);
+    for (size_t b = 0; b < masks.size(); b++)
+    {
+        const std::vector<char> &mask = masks[b];
+        std::vector<size_t> boxHits;
+        for (size_t i = 0; i < mask.size(); i++)
+        {
+            if (mask[i])
+            {
+                boxHits.push_back(i);
+                values.push_back(data[b][i]);
+            }
+        }
+        if (boxHits.empty())
+            continue;
+        touchedBlocks.push_back(candidates[b]);
+        hits.push_back(std::move(boxHits));
+    }
+}
+
+#define declare_template_instantiation(T)                                      \
+    template void Worker::GetResultValues(std::vector<Box<Dims>> &,            \
+                                          std::vector<std::vector<size_t>> &,  \
+                                          std::vector<T> &);
+ADIOS2_FOREACH_ATTRIBUTE_PRIMITIVE_STDTYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+
+void Worker::ExchangeCoverage(
+    const helper::Comm &comm, const std::vector<size_t> &myIndices,
+    std::vector<std::vector<Box<Dims>>> &touchedBlocks)
+{
+    // [index, nBoxes, nDims, (start, count) x nBoxes] for each local step
+    std::vector<size_t> send;
+    for (const size_t i : myIndices)
+    {
+        const std::vector<Box<Dims>> &boxes = touchedBlocks[i];
+        const size_t nDims = boxes.empty() ? 0 : boxes.front().first.size();
+        send.push_back(i);
+        send.push_back(boxes.size());
+        send.push_back(nDims);
+        for (const auto &box : boxes)
+        {
+            send.insert(send.end(), box.first.begin(), box.first.end());
+            send.insert(send.end(), box.second.begin(), box.second.end());
+        }
+    }
+
+    const std::vector<size_t> counts = comm.AllGatherValues(send.size());
+    std::vector<size_t> displs(counts.size(), 0);
+    for (size_t r = 1; r < counts.size(); ++r)
+        displs[r] = displs[r - 1] + counts[r - 1];
+    std::vector<size_t> recv(displs.back() + counts.back());
+    comm.Allgatherv(send.data(), send.size(), recv.data(), counts.data(),
+                    displs.data());
+
+    size_t pos = 0;
+    while (pos < recv.size())
+    {
+        const size_t i = recv[pos++];
+        const size_t nBoxes = recv[pos++];
+        const size_t nDims = recv[pos++];
+        std::vector<Box<Dims>> &boxes = touchedBlocks[i];
+        boxes.resize(nBoxes);
+        for (auto &box : boxes)
+        {
+            box.first.assign(recv.begin() + pos, recv.begin() + pos + nDims);
+            pos += nDims;
+            box.second.assign(recv.begin() + pos, recv.begin() + pos + nDims);
+            pos += nDims;
+        }
+    }
+}
 } // namespace query
 } // namespace adios2
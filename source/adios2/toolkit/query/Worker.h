@@ -45,6 +45,49 @@ public:
     void GetResultCoverage(const adios2::Box<adios2::Dims> &,
                            std::vector<Box<adios2::Dims>> &);
 
+    /**
+     * Evaluates the query for steps [firstStep, firstStep + nSteps) of a
+     * reader opened for random access (BP5 ReadRandomAccess, BP3/BP4 Read
+     * outside of BeginStep/EndStep). Steps are distributed round-robin over
+     * the reader's communicator and over nThreads threads within a rank, the
+     * coverage of all steps is available on every rank afterwards.
+     * Collective over the reader's communicator.
+     * @param outputRegion as in the single step version
+     * @param firstStep absolute step to start with
+     * @param nSteps number of steps, clipped to the available steps
+     * @param touchedBlocks per step result, touchedBlocks[i] is the coverage
+     * of firstStep + i
+     * @param nThreads threads evaluating steps on this rank
+     */
+    void GetResultCoverage(const adios2::Box<adios2::Dims> &outputRegion,
+                           const size_t firstStep, const size_t nSteps,
+                           std::vector<std::vector<Box<adios2::Dims>>>
+                               &touchedBlocks,
+                           const unsigned int nThreads = 1);
+
+    /**
+     * Element level result for the current step: the regions touched by
+     * the query are clipped so that they do not overlap, read with a single
+     * PerformGets and every element is checked.
+     * Regions and offsets refer to the variable's global coordinates, the
+     * output region is not applied (and is left as it was).
+     * @param touchedBlocks disjoint regions with at least one matching
+     * element
+     * @param hits hits[i] are the row-major offsets within touchedBlocks[i]
+     * of the matching elements
+     */
+    void GetResultHits(std::vector<Box<adios2::Dims>> &touchedBlocks,
+                       std::vector<std::vector<size_t>> &hits);
+
+    /**
+     * GetResultHits that also returns the matching values, in the order of
+     * the hits. Only for queries on a single variable of type T.
+     */
+    template <class T>
+    void GetResultValues(std::vector<Box<adios2::Dims>> &touchedBlocks,
+                         std::vector<std::vector<size_t>> &hits,
+                         std::vector<T> &values);
+
 protected:
     Worker(const std::string &configFile, adios2::core::Engine *adiosEngine);
 
@@ -57,6 +100,11 @@ protected:
     adios2::query::QueryBase *m_Query = nullptr;
 
 private:
+    /** makes the per step coverage evaluated on each rank known to all */
+    void ExchangeCoverage(const helper::Comm &comm,
+                          const std::vector<size_t> &myIndices,
+                          std::vector<std::vector<Box<adios2::Dims>>>
+                              &touchedBlocks);
 }; // worker
 
 #ifdef ADIOS2_HAVE_DATAMAN
@@ -0,0 +1,57 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Futex.cpp
+ *
+ */
+
+#include "Futex.h"
+
+#ifdef __linux__
+#include <climits> // INT_MAX
+#include <ctime>   // timespec
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <chrono>
+#include <thread>
+#endif
+
+namespace adios2
+{
+namespace shm
+{
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "futex word must be a plain 32-bit integer");
+
+void FutexWait(std::atomic<uint32_t> &word, const uint32_t expected)
+{
+#ifdef __linux__
+    // the kernel compares the word with expected atomically before sleeping,
+    // the timeout only bounds the wait if a wakeup is ever lost
+    struct timespec timeout = {0, 1000000};
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT,
+            expected, &timeout, nullptr, 0);
+#else
+    if (word.load() == expected)
+    {
+        std::this_thread::sleep_for(std::chrono::duration<double>(0.00001));
+    }
+#endif
+}
+
+void FutexWakeAll(std::atomic<uint32_t> &word)
+{
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE,
+            INT_MAX, nullptr, nullptr, 0);
+#else
+    (void)word;
+#endif
+}
+
+} // end namespace shm
+} // end namespace adios2
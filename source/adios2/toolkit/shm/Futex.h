@@ -0,0 +1,38 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Futex.h
+ *
+ * Blocking wait on a 32-bit word in memory shared between processes, and
+ * wakeup of the waiters after the word was changed. On Linux this is the
+ * futex system call, so a waiting process sleeps in the kernel and is woken
+ * up right away instead of polling. Elsewhere the wait falls back to short
+ * sleeps.
+ *
+ * The word must be changed before FutexWakeAll() is called, and waiters
+ * must check the word again after FutexWait() returns: it can return
+ * without a change.
+ */
+
+#ifndef ADIOS2_TOOLKIT_SHM_FUTEX_H_
+#define ADIOS2_TOOLKIT_SHM_FUTEX_H_
+
+#include <atomic>
+#include <cstdint>
+
+namespace adios2
+{
+namespace shm
+{
+
+/** block the calling process while word == expected */
+void FutexWait(std::atomic<uint32_t> &word, const uint32_t expected);
+
+/** wake up all processes blocked in FutexWait() on word */
+void FutexWakeAll(std::atomic<uint32_t> &word);
+
+} // end namespace shm
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_SHM_FUTEX_H_ */
@@ -19,7 +19,9 @@
 
 #include "Reorganize.h"
 
+#include <algorithm>
 #include <assert.h>
+#include <future>
 #include <iomanip>
 #include <string>
 
@@ -61,24 +63,47 @@ Reorganize::Reorganize(int argc, char *argv[])
     m_Rank = m_Comm.Rank();
     m_Size = m_Comm.Size();
 
-    if (argc < 7)
+    // options come before the positional arguments
+    int first = 1;
+    while (argc > first && argv[first][0] == '-')
+    {
+        const std::string option(argv[first]);
+        if (option == "-p" || option == "--pipeline")
+        {
+            pipeline = true;
+        }
+        else if (option == "-b" || option == "--blocks")
+        {
+            blockDecomp = true;
+        }
+        else
+        {
+            PrintUsage();
+            helper::Throw<std::invalid_argument>(
+                "Utils", "AdiosReorganize", "Reorganize",
+                "Unknown option " + option);
+        }
+        first++;
+    }
+
+    if (argc < first + 6)
     {
         PrintUsage();
         helper::Throw<std::invalid_argument>(
             "Utils", "AdiosReorganize", "Reorganize",
             "Not enough arguments. At least 6 are required");
     }
-    infilename = std::string(argv[1]);
-    outfilename = std::string(argv[2]);
-    rmethodname = std::string(argv[3]);
-    rmethodparam_str = std::string(argv[4]);
-    wmethodname = std::string(argv[5]);
-    wmethodparam_str = std::string(argv[6]);
+    infilename = std::string(argv[first]);
+    outfilename = std::string(argv[first + 1]);
+    rmethodname = std::string(argv[first + 2]);
+    rmethodparam_str = std::string(argv[first + 3]);
+    wmethodname = std::string(argv[first + 4]);
+    wmethodparam_str = std::string(argv[first + 5]);
 
     int nd = 0;
-    int j = 7;
+    int j = first + 6;
     char *end;
-    while (argc > j && j < 13)
+    while (argc > j && j < first + 12)
     { // get max 6 dimensions
         errno = 0;
         decomp_values[nd] = std::strtol(argv[j], &end, 10);
@@ -134,6 +159,14 @@ void Reorganize::Run()
     print0("Read method parameters  = ", rmethodparam_str);
     print0("Write method            = ", wmethodname);
     print0("Write method parameters = ", wmethodparam_str);
+    if (pipeline)
+    {
+        print0("Pipelined: reading the next step while writing");
+    }
+    if (blockDecomp)
+    {
+        print0("Decomposition: whole blocks of the writers");
+    }
 
     core::ADIOS adios(m_Comm.Duplicate(), "C++");
     core::IO &io = adios.DeclareIO("group");
@@ -145,10 +178,12 @@ void Reorganize::Run()
     core::Engine &rStream = io.Open(infilename, adios2::Mode::Read);
     // rStream.FixedSchedule();
 
-    io.ClearParameters();
-    io.SetEngine(wmethodname);
-    io.SetParameters(wmethodparams);
-    core::Engine &wStream = io.Open(outfilename, adios2::Mode::Write);
+    // the reader may redefine its variables in every step, so the writer
+    // has its own IO and defines the variables it writes there
+    core::IO &wio = adios.DeclareIO("output");
+    wio.SetEngine(wmethodname);
+    wio.SetParameters(wmethodparams);
+    core::Engine &wStream = wio.Open(outfilename, adios2::Mode::Write);
 
     int steps = 0;
     int curr_step = -1;
@@ -210,13 +245,32 @@ void Reorganize::Run()
         if (retval)
             break;
 
-        retval = ReadWrite(rStream, wStream, io, variables, steps);
+        if (steps == 1)
+        {
+            CopyAttributes(io, wio);
+        }
+        if (pipeline)
+        {
+            retval = ReadWritePipelined(rStream, wStream, wio, variables);
+        }
+        else
+        {
+            retval = ReadWrite(rStream, wStream, wio, variables, steps);
+        }
         if (retval)
             break;
 
         CleanUpStep(io);
     }
 
+    if (havePendingStep)
+    {
+        // the last step read in pipelined mode
+        WriteVariables(wStream, wio, pendingStep);
+        FreeBuffers(pendingStep);
+        havePendingStep = false;
+    }
+
     rStream.Close();
     wStream.Close();
     print0("Bye after processing ", steps, " steps");
@@ -289,9 +343,16 @@ void Reorganize::ProcessParameters()
 void Reorganize::PrintUsage() const noexcept
 {
     std::cout
-        << "Usage: adios_reorganize input output rmethod \"params\" wmethod "
-           "\"params\" "
+        << "Usage: adios_reorganize [-p] [-b] input output rmethod "
+           "\"params\" wmethod \"params\" "
            "<decomposition>\n"
+           "    -p, --pipeline\n"
+           "            Read the next step while the previous one is being\n"
+           "            written. Needs memory for two steps.\n"
+           "    -b, --blocks\n"
+           "            Distribute the blocks of global arrays as they were\n"
+           "            written over all processes, balanced by size, instead\n"
+           "            of the <decomposition>. No block is read partially.\n"
            "    input   Input stream path\n"
            "    output  Output file path\n"
            "    rmethod ADIOS method to read with\n"
@@ -332,14 +393,7 @@ std::vector<VarInfo> varinfo;
 //
 void Reorganize::CleanUpStep(core::IO &io)
 {
-    for (auto &vi : varinfo)
-    {
-        if (vi.readbuf != nullptr)
-        {
-            free(vi.readbuf);
-        }
-    }
-    varinfo.clear();
+    FreeBuffers(varinfo);
     // io.RemoveAllVariables();
     // io.RemoveAllAttributes();
 }
@@ -483,6 +537,81 @@ Reorganize::Decompose(int numproc, int rank, VarInfo &vi,
     return writesize;
 }
 
+template <class T>
+std::vector<Box<Dims>>
+Reorganize::WriterBlocks(core::Engine &rStream, const core::Variable<T> &v)
+{
+    std::vector<Box<Dims>> boxes;
+    MinVarInfo *minBlocks = rStream.MinBlocksInfo(v, rStream.CurrentStep());
+    if (minBlocks)
+    {
+        // local values presented as an array have no blocks to keep whole,
+        // they are decomposed as usual
+        const size_t ndim = static_cast<size_t>(minBlocks->Dims);
+        for (const auto &b : minBlocks->BlocksInfo)
+        {
+            if (minBlocks->WasLocalVar)
+            {
+                break;
+            }
+            boxes.emplace_back(Dims(b.Start, b.Start + ndim),
+                               Dims(b.Count, b.Count + ndim));
+            if (minBlocks->IsReverseDims)
+            {
+                std::reverse(boxes.back().first.begin(),
+                             boxes.back().first.end());
+                std::reverse(boxes.back().second.begin(),
+                             boxes.back().second.end());
+            }
+        }
+        delete minBlocks;
+        return boxes;
+    }
+    for (const auto &b : rStream.BlocksInfo(v, rStream.CurrentStep()))
+    {
+        boxes.emplace_back(b.Start, b.Count);
+    }
+    return boxes;
+}
+
+/*
+ * Distribute the blocks of a global array as they were written: the largest
+ * block goes to the least loaded process first (lowest rank on a tie), so
+ * each process reads whole blocks only and the bytes are balanced. Every
+ * process computes the same assignment.
+ */
+size_t Reorganize::DecomposeBlocks(int numproc, int rank, VarInfo &vi,
+                                   const std::vector<Box<Dims>> &writerBlocks)
+{
+    std::vector<size_t> sizes(writerBlocks.size());
+    std::vector<size_t> order(writerBlocks.size());
+    for (size_t b = 0; b < writerBlocks.size(); ++b)
+    {
+        sizes[b] = helper::GetTotalSize(writerBlocks[b].second);
+        order[b] = b;
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+
+    std::vector<size_t> load(static_cast<size_t>(numproc), 0);
+    size_t writesize = 0;
+    for (const size_t b : order)
+    {
+        const auto least = std::min_element(load.begin(), load.end());
+        *least += sizes[b];
+        if (least - load.begin() == rank)
+        {
+            vi.blocks.push_back(writerBlocks[b]);
+            writesize += sizes[b];
+        }
+    }
+
+    std::cout << "rank " << rank << ": " << vi.blocks.size() << " of "
+              << writerBlocks.size() << " blocks, " << writesize
+              << " elements" << std::endl;
+    return writesize;
+}
+
 int Reorganize::ProcessMetadata(core::Engine &rStream, core::IO &io,
                                 const core::VarMap &variables,
                                 const core::AttrMap &attributes, int step)
@@ -502,6 +631,7 @@ int Reorganize::ProcessMetadata(core::Engine &rStream, core::IO &io,
         core::VariableBase *variable = nullptr;
         print0("Get info on variable ", varidx, ": ", name);
         size_t nBlocks = 1;
+        std::vector<Box<Dims>> writerBlocks; // -b only, else Decompose()
 
         if (type == DataType::Compound)
         {
@@ -517,15 +647,35 @@ int Reorganize::ProcessMetadata(core::Engine &rStream, core::IO &io,
             auto blocks = rStream.BlocksInfo(*v, rStream.CurrentStep());       \
             nBlocks = blocks.size();                                           \
         }                                                                      \
+        else if (blockDecomp && v->m_ShapeID == adios2::ShapeID::GlobalArray)  \
+        {                                                                      \
+            writerBlocks = WriterBlocks(rStream, *v);                          \
+        }                                                                      \
         variable = v;                                                          \
     }
         ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
 
+        if (variable != nullptr && type == DataType::String &&
+            variable->m_ShapeID == adios2::ShapeID::GlobalArray)
+        {
+            // local string values are presented as an array of strings,
+            // which cannot be defined for writing
+            print0("    string array ", name, " is not supported, skipped");
+            variable = nullptr;
+        }
+
         varinfo[varidx].v = variable;
 
         if (variable != nullptr)
         {
+            varinfo[varidx].name = name;
+            varinfo[varidx].datatype = type;
+            varinfo[varidx].shapeid = variable->m_ShapeID;
+            if (variable->m_ShapeID == adios2::ShapeID::GlobalArray)
+            {
+                varinfo[varidx].shape = variable->GetShape();
+            }
 
             // print variable type and dimensions
             if (!m_Rank)
@@ -571,7 +721,11 @@ int Reorganize::ProcessMetadata(core::Engine &rStream, core::IO &io,
 
             // determine subset we will write
             size_t sum_count =
-                Decompose(m_Size, m_Rank, varinfo[varidx], decomp_values);
+                !writerBlocks.empty()
+                    ? DecomposeBlocks(m_Size, m_Rank, varinfo[varidx],
+                                      writerBlocks)
+                    : Decompose(m_Size, m_Rank, varinfo[varidx],
+                                decomp_values);
             varinfo[varidx].writesize = sum_count * variable->m_ElementSize;
 
             if (varinfo[varidx].writesize != 0)
@@ -615,7 +769,47 @@ int Reorganize::ProcessMetadata(core::Engine &rStream, core::IO &io,
 }
 
 int Reorganize::ReadWrite(core::Engine &rStream, core::Engine &wStream,
-                          core::IO &io, const core::VarMap &variables, int step)
+                          core::IO &wio, const core::VarMap &variables,
+                          int step)
+{
+    int retval = ReadVariables(rStream, variables);
+    rStream.EndStep(); // read in data into allocated pointers
+    if (!retval)
+    {
+        retval = WriteVariables(wStream, wio, varinfo);
+    }
+    return retval;
+}
+
+/*
+ * Pipelined mode: the reads of this step run in the background while the
+ * previous step is written, then this step is kept until the next call.
+ * At most two steps are in memory.
+ */
+int Reorganize::ReadWritePipelined(core::Engine &rStream,
+                                   core::Engine &wStream, core::IO &wio,
+                                   const core::VarMap &variables)
+{
+    int retval = ReadVariables(rStream, variables);
+    std::future<void> reads = rStream.PerformGetsAsync();
+    if (havePendingStep)
+    {
+        if (!retval)
+        {
+            retval = WriteVariables(wStream, wio, pendingStep);
+        }
+        FreeBuffers(pendingStep);
+        havePendingStep = false;
+    }
+    reads.get();
+    rStream.EndStep();
+    pendingStep.swap(varinfo);
+    havePendingStep = true;
+    return retval;
+}
+
+int Reorganize::ReadVariables(core::Engine &rStream,
+                              const core::VarMap &variables)
 {
     int retval = 0;
 
@@ -654,7 +848,17 @@ int Reorganize::ReadWrite(core::Engine &rStream, core::Engine &wStream,
     else if (type == helper::GetDataType<T>())                                 \
     {                                                                          \
         varinfo[varidx].readbuf = calloc(1, varinfo[varidx].writesize);        \
-        if (varinfo[varidx].count.size() == 0)                                 \
+        if (!varinfo[varidx].blocks.empty())                                   \
+        {                                                                      \
+            T *data = reinterpret_cast<T *>(varinfo[varidx].readbuf);          \
+            for (const auto &block : varinfo[varidx].blocks)                   \
+            {                                                                  \
+                varinfo[varidx].v->SetSelection(block);                        \
+                rStream.Get<T>(name, data);                                    \
+                data += helper::GetTotalSize(block.second);                    \
+            }                                                                  \
+        }                                                                      \
+        else if (varinfo[varidx].count.size() == 0)                            \
         {                                                                      \
             rStream.Get<T>(name,                                               \
                            reinterpret_cast<T *>(varinfo[varidx].readbuf),     \
@@ -673,48 +877,78 @@ int Reorganize::ReadWrite(core::Engine &rStream, core::Engine &wStream,
             }
         }
     }
-    rStream.EndStep(); // read in data into allocated pointers
+    return retval;
+}
+
+/*
+ * Write all variables of a step read before, defining them in the IO of
+ * the writer on their first write
+ */
+int Reorganize::WriteVariables(core::Engine &wStream, core::IO &io,
+                               const std::vector<VarInfo> &infos)
+{
+    int retval = 0;
 
-    /*
-     * Write all variables
-     */
     wStream.BeginStep();
-    for (size_t varidx = 0; varidx < nvars; ++varidx)
+    for (const auto &vi : infos)
     {
-        if (varinfo[varidx].v != nullptr)
+        if (vi.v != nullptr)
         {
-            const std::string &name = varinfo[varidx].v->m_Name;
-            if (varinfo[varidx].writesize != 0)
+            if (vi.writesize != 0)
             {
                 // Write variable subset
-                std::cout << "rank " << m_Rank << ": Write variable " << name
-                          << std::endl;
-                const DataType type = variables.at(name)->m_Type;
-                if (type == DataType::Compound)
+                std::cout << "rank " << m_Rank << ": Write variable "
+                          << vi.name << std::endl;
+                if (vi.datatype == DataType::Compound)
                 {
                     // not supported
                 }
 #define declare_template_instantiation(T)                                      \
-    else if (type == helper::GetDataType<T>())                                 \
+    else if (vi.datatype == helper::GetDataType<T>())                          \
     {                                                                          \
-        if (varinfo[varidx].count.size() == 0)                                 \
+        core::Variable<T> *v = io.InquireVariable<T>(vi.name);                 \
+        if (v == nullptr && !vi.blocks.empty())                                \
         {                                                                      \
-            wStream.Put<T>(name,                                               \
-                           reinterpret_cast<T *>(varinfo[varidx].readbuf),     \
+            v = &io.DefineVariable<T>(vi.name, vi.shape,                       \
+                                      vi.blocks.front().first,                 \
+                                      vi.blocks.front().second);               \
+        }                                                                      \
+        else if (v == nullptr)                                                 \
+        {                                                                      \
+            v = &io.DefineVariable<T>(vi.name, vi.shape, vi.start, vi.count);  \
+        }                                                                      \
+        if (!vi.blocks.empty())                                                \
+        {                                                                      \
+            if (v->m_Shape != vi.shape)                                        \
+            {                                                                  \
+                v->SetShape(vi.shape);                                         \
+            }                                                                  \
+            const T *data = reinterpret_cast<const T *>(vi.readbuf);           \
+            for (const auto &block : vi.blocks)                                \
+            {                                                                  \
+                v->SetSelection(block);                                        \
+                wStream.Put<T>(*v, data);                                      \
+                data += helper::GetTotalSize(block.second);                    \
+            }                                                                  \
+        }                                                                      \
+        else if (vi.count.size() == 0)                                         \
+        {                                                                      \
+            wStream.Put<T>(*v, reinterpret_cast<T *>(vi.readbuf),              \
                            adios2::Mode::Sync);                                \
         }                                                                      \
-        else if (varinfo[varidx].v->m_ShapeID == adios2::ShapeID::LocalArray)  \
+        else if (vi.shapeid == adios2::ShapeID::LocalArray)                    \
         {                                                                      \
-            wStream.Put<T>(name,                                               \
-                           reinterpret_cast<T *>(varinfo[varidx].readbuf),     \
+            wStream.Put<T>(*v, reinterpret_cast<T *>(vi.readbuf),              \
                            adios2::Mode::Sync);                                \
         }                                                                      \
         else                                                                   \
         {                                                                      \
-            varinfo[varidx].v->SetSelection(                                   \
-                {varinfo[varidx].start, varinfo[varidx].count});               \
-            wStream.Put<T>(name,                                               \
-                           reinterpret_cast<T *>(varinfo[varidx].readbuf));    \
+            if (v->m_Shape != vi.shape)                                        \
+            {                                                                  \
+                v->SetShape(vi.shape);                                         \
+            }                                                                  \
+            v->SetSelection({vi.start, vi.count});                             \
+            wStream.Put<T>(*v, reinterpret_cast<T *>(vi.readbuf));             \
         }                                                                      \
     }
                 ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
@@ -726,5 +960,47 @@ int Reorganize::ReadWrite(core::Engine &rStream, core::Engine &wStream,
     return retval;
 }
 
+void Reorganize::FreeBuffers(std::vector<VarInfo> &infos)
+{
+    for (auto &vi : infos)
+    {
+        if (vi.readbuf != nullptr)
+        {
+            free(vi.readbuf);
+        }
+    }
+    infos.clear();
+}
+
+void Reorganize::CopyAttributes(const core::IO &from, core::IO &to)
+{
+    for (const auto &attributePair : from.GetAttributes())
+    {
+        const core::AttributeBase *attribute = attributePair.second.get();
+        const DataType type = attribute->m_Type;
+        if (type == DataType::Compound)
+        {
+            // not supported
+        }
+#define declare_template_instantiation(T)                                      \
+    else if (type == helper::GetDataType<T>())                                 \
+    {                                                                          \
+        const core::Attribute<T> *a =                                          \
+            dynamic_cast<const core::Attribute<T> *>(attribute);               \
+        if (a->m_IsSingleValue)                                                \
+        {                                                                      \
+            to.DefineAttribute<T>(attributePair.first, a->m_DataSingleValue);  \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            to.DefineAttribute<T>(attributePair.first, a->m_DataArray.data(),  \
+                                  a->m_DataArray.size());                      \
+        }                                                                      \
+    }
+        ADIOS2_FOREACH_ATTRIBUTE_STDTYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+    }
+}
+
 } // end namespace utils
 } // end namespace adios2
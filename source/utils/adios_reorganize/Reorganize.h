@@ -28,6 +28,14 @@ struct VarInfo
     Dims count;
     size_t writesize = 0; // size of subset this process writes, 0: do not write
     void *readbuf = nullptr; // read in buffer
+    // copied from v, which is only valid in the step it was read in
+    std::string name;
+    DataType datatype = DataType::None;
+    ShapeID shapeid = ShapeID::Unknown;
+    Dims shape;
+    // -b: whole writer blocks this process reads and writes, one after the
+    // other in readbuf; start and count are not used then
+    std::vector<Box<Dims>> blocks;
 };
 
 class Reorganize : public Utils
@@ -60,11 +68,23 @@ private:
     size_t Decompose(int numproc, int rank, VarInfo &vi,
                      const int *np // number of processes in each dimension
     );
+    template <class T>
+    std::vector<Box<Dims>> WriterBlocks(core::Engine &rStream,
+                                        const core::Variable<T> &v);
+    size_t DecomposeBlocks(int numproc, int rank, VarInfo &vi,
+                           const std::vector<Box<Dims>> &writerBlocks);
     int ProcessMetadata(core::Engine &rStream, core::IO &io,
                         const core::VarMap &variables,
                         const core::AttrMap &attributes, int step);
-    int ReadWrite(core::Engine &rStream, core::Engine &wStream, core::IO &io,
+    int ReadWrite(core::Engine &rStream, core::Engine &wStream, core::IO &wio,
                   const core::VarMap &variables, int step);
+    int ReadWritePipelined(core::Engine &rStream, core::Engine &wStream,
+                           core::IO &wio, const core::VarMap &variables);
+    int ReadVariables(core::Engine &rStream, const core::VarMap &variables);
+    int WriteVariables(core::Engine &wStream, core::IO &io,
+                       const std::vector<VarInfo> &infos);
+    void FreeBuffers(std::vector<VarInfo> &infos);
+    void CopyAttributes(const core::IO &from, core::IO &to);
     Params parseParams(const std::string &param_str);
 
     // Input arguments
@@ -101,6 +121,16 @@ private:
 
     int decomp_values[10] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
 
+    // -p: read the next step while the previous one is written
+    bool pipeline = false;
+    // the step read last in pipelined mode, written with the next one
+    std::vector<VarInfo> pendingStep;
+    bool havePendingStep = false;
+
+    // -b: assign whole writer blocks to processes instead of decomposing
+    // the arrays by decomp_values
+    bool blockDecomp = false;
+
     template <typename Arg, typename... Args>
     void print0(Arg &&arg, Args &&... args);
 
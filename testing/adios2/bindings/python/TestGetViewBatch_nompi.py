@@ -0,0 +1,98 @@
+#!/usr/bin/env python
+#
+# Distributed under the OSI-approved Apache License, Version 2.0.  See
+# accompanying file Copyright.txt for details.
+#
+# TestGetViewBatch_nompi.py: test Engine.GetView and Engine.GetBatch
+import unittest
+import shutil
+import numpy as np
+import adios2
+
+TESTDATA_FILENAME = "get_batch.bp"
+
+
+class TestGetViewBatch(unittest.TestCase):
+
+    def test_get_batch(self):
+        adios = adios2.ADIOS()
+        ioWrite = adios.DeclareIO("batchWrite")
+        a = np.arange(24, dtype=np.float64).reshape(4, 6)
+        b = np.arange(10, dtype=np.int32)
+        varA = ioWrite.DefineVariable("a", a, [4, 6], [0, 0], [4, 6])
+        varB = ioWrite.DefineVariable("b", b, [10], [0], [10])
+        writer = ioWrite.Open(TESTDATA_FILENAME, adios2.Mode.Write)
+        writer.Put(varA, a)
+        writer.Put(varB, b)
+        writer.Close()
+
+        ioRead = adios.DeclareIO("batchRead")
+        reader = ioRead.Open(TESTDATA_FILENAME, adios2.Mode.Read)
+        varA = ioRead.InquireVariable("a")
+        varB = ioRead.InquireVariable("b")
+        arrays = reader.GetBatch([(varA, [1, 2], [2, 3]),
+                                  (varB, [], []),
+                                  (varB, [4], [3])])
+        reader.Close()
+        shutil.rmtree(TESTDATA_FILENAME)
+
+        self.assertEqual(len(arrays), 3)
+        self.assertTrue(np.array_equal(arrays[0], a[1:3, 2:5]))
+        self.assertTrue(np.array_equal(arrays[1], b))
+        self.assertTrue(np.array_equal(arrays[2], b[4:7]))
+
+    def test_get_view_inline(self):
+        adios = adios2.ADIOS()
+        io = adios.DeclareIO("viewInline")
+        io.SetEngine("Inline")
+        a = np.arange(24, dtype=np.float32).reshape(4, 6)
+        varA = io.DefineVariable("a", a, [4, 6], [0, 0], [4, 6])
+        writer = io.Open("view_write", adios2.Mode.Write)
+        reader = io.Open("view_read", adios2.Mode.Read)
+
+        writer.BeginStep()
+        writer.Put(varA, a)
+        writer.EndStep()
+
+        reader.BeginStep()
+        var = io.InquireVariable("a")
+        var.SetSelection([[1, 2], [2, 3]])
+        view = reader.GetView(var)
+        self.assertFalse(view.flags.writeable)
+        self.assertFalse(view.flags.owndata)
+        self.assertTrue(np.array_equal(view, a[1:3, 2:5]))
+        reader.EndStep()
+
+        writer.Close()
+        reader.Close()
+
+    def test_get_view_outlives_step(self):
+        adios = adios2.ADIOS()
+        io = adios.DeclareIO("viewStep")
+        io.SetEngine("Inline")
+        a = np.arange(24, dtype=np.float64).reshape(4, 6)
+        varA = io.DefineVariable("a", a, [4, 6], [0, 0], [4, 6])
+        writer = io.Open("view_write", adios2.Mode.Write)
+        reader = io.Open("view_read", adios2.Mode.Read)
+
+        # the writer keeps no reference to the arrays it puts
+        writer.BeginStep()
+        writer.Put(varA, a.copy())
+        writer.EndStep()
+        reader.BeginStep()
+        view = reader.GetView(io.InquireVariable("a"))
+        reader.EndStep()
+
+        writer.BeginStep()
+        writer.Put(varA, np.zeros((4, 6)))
+        writer.EndStep()
+
+        # the view holds its step, and so the array put in it
+        self.assertTrue(np.array_equal(view, a))
+
+        writer.Close()
+        reader.Close()
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,204 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Test the "DataChecksum" parameter of the BP5 writer
+ */
+
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+constexpr std::size_t NSteps = 10;
+constexpr std::size_t Nx = 10;
+using DataArray = std::array<int32_t, Nx>;
+
+class BPDataChecksum : public ::testing::Test
+{
+public:
+    BPDataChecksum() = default;
+
+    DataArray GenerateData(int step, int rank, int size)
+    {
+        DataArray d;
+        d.fill(rank + 1 + step * size);
+        return d;
+    }
+};
+
+TEST_F(BPDataChecksum, Corruption)
+{
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    const std::string filename =
+        "DataChecksum" + std::to_string(mpiSize) + ".bp";
+    const int32_t DeferredShift = 1000;
+    const int32_t SpanShift = 2000;
+    {
+        adios2::IO ioWrite = adios.DeclareIO("TestIOWrite");
+        ioWrite.SetEngine(engineName);
+        ioWrite.SetParameter("DataChecksum", "true");
+        adios2::Engine engine = ioWrite.Open(filename, adios2::Mode::Write);
+        const adios2::Dims shape{mpiSize * Nx};
+        const adios2::Dims start{mpiRank * Nx};
+        const adios2::Dims count{Nx};
+        auto var = ioWrite.DefineVariable<int32_t>("var", shape, start, count);
+        auto varDeferred =
+            ioWrite.DefineVariable<int32_t>("varDeferred", shape, start, count);
+        auto varSpan =
+            ioWrite.DefineVariable<int32_t>("varSpan", shape, start, count);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            auto d = GenerateData(static_cast<int>(step), mpiRank, mpiSize);
+            DataArray dDeferred;
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                dDeferred[i] = d[i] + DeferredShift;
+            }
+            engine.BeginStep();
+            engine.Put(var, d.data(), adios2::Mode::Sync);
+            engine.Put(varDeferred, dDeferred.data());
+            adios2::Variable<int32_t>::Span span = engine.Put(varSpan);
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                span[i] = d[i] + SpanShift;
+            }
+            engine.EndStep();
+        }
+        engine.Close();
+    }
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    // the checksum fields need BP minor version 4 readers
+    if (engineName == "BP5" && mpiRank == 0)
+    {
+        std::ifstream index(filename + "/md.idx", std::ios::binary);
+        index.seekg(38);
+        EXPECT_EQ(index.get(), 4);
+    }
+
+    // intact file, every block verifies
+    {
+        adios2::IO ioRead = adios.DeclareIO("TestIORead");
+        ioRead.SetEngine(engineName);
+        adios2::Engine engine_s = ioRead.Open(filename, adios2::Mode::Read);
+        size_t step = 0;
+        while (engine_s.BeginStep() == adios2::StepStatus::OK)
+        {
+            auto d = GenerateData(static_cast<int>(step), mpiRank, mpiSize);
+            std::vector<int32_t> res, resDeferred, resSpan;
+            auto var = ioRead.InquireVariable<int32_t>("var");
+            auto varDeferred = ioRead.InquireVariable<int32_t>("varDeferred");
+            auto varSpan = ioRead.InquireVariable<int32_t>("varSpan");
+            var.SetSelection({{Nx * mpiRank}, {Nx}});
+            varDeferred.SetSelection({{Nx * mpiRank}, {Nx}});
+            varSpan.SetSelection({{Nx * mpiRank}, {Nx}});
+            engine_s.Get(var, res);
+            engine_s.Get(varDeferred, resDeferred);
+            engine_s.Get(varSpan, resSpan);
+            engine_s.EndStep();
+            EXPECT_EQ(res[0], d[0]);
+            EXPECT_EQ(resDeferred[Nx - 1], d[Nx - 1] + DeferredShift);
+            EXPECT_EQ(resSpan[Nx - 1], d[Nx - 1] + SpanShift);
+            ++step;
+        }
+        EXPECT_EQ(step, NSteps);
+        engine_s.Close();
+    }
+
+    // flip one byte of rank 0's "var" block of the first step
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+    if (mpiRank == 0)
+    {
+        const std::string dataName = filename + "/data.0";
+        std::vector<char> contents;
+        {
+            std::ifstream in(dataName, std::ios::binary);
+            contents.assign(std::istreambuf_iterator<char>(in),
+                            std::istreambuf_iterator<char>());
+        }
+        auto d = GenerateData(0, 0, mpiSize);
+        auto pos = std::search(contents.begin(), contents.end(),
+                               reinterpret_cast<const char *>(d.data()),
+                               reinterpret_cast<const char *>(d.data()) +
+                                   sizeof(d));
+        ASSERT_NE(pos, contents.end());
+        std::fstream out(dataName,
+                         std::ios::binary | std::ios::in | std::ios::out);
+        out.seekp(pos - contents.begin() + 1);
+        out.put(static_cast<char>(pos[1] ^ 0x10));
+    }
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    {
+        adios2::IO ioRead = adios.DeclareIO("TestIOReadCorrupt");
+        ioRead.SetEngine(engineName);
+        adios2::Engine engine_s =
+            ioRead.Open(filename, adios2::Mode::ReadRandomAccess);
+        auto var = ioRead.InquireVariable<int32_t>("var");
+        auto varSpan = ioRead.InquireVariable<int32_t>("varSpan");
+        std::vector<int32_t> res;
+        var.SetSelection({{0}, {mpiSize * Nx}});
+        var.SetStepSelection(adios2::Box<size_t>(0, 1));
+        EXPECT_THROW(engine_s.Get(var, res, adios2::Mode::Sync),
+                     std::runtime_error);
+        // other blocks are not affected
+        var.SetStepSelection(adios2::Box<size_t>(1, 1));
+        engine_s.Get(var, res, adios2::Mode::Sync);
+        EXPECT_EQ(res[0], GenerateData(1, 0, mpiSize)[0]);
+        varSpan.SetSelection({{0}, {mpiSize * Nx}});
+        varSpan.SetStepSelection(adios2::Box<size_t>(0, 1));
+        engine_s.Get(varSpan, res, adios2::Mode::Sync);
+        EXPECT_EQ(res[0], GenerateData(0, 0, mpiSize)[0] + SpanShift);
+        engine_s.Close();
+    }
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
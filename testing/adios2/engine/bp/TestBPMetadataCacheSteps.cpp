@@ -0,0 +1,128 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Test the "MetadataCacheSteps" parameter of the BP5 reader
+ */
+
+#include <cstdint>
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+constexpr std::size_t NSteps = 10;
+constexpr std::size_t Nx = 10;
+using DataArray = std::array<int32_t, Nx>;
+
+class BPMetadataCacheSteps : public ::testing::Test
+{
+public:
+    BPMetadataCacheSteps() = default;
+
+    DataArray GenerateData(int step, int rank, int size)
+    {
+        DataArray d;
+        d.fill(rank + 1 + step * size);
+        return d;
+    }
+
+    void CreateOutput(adios2::ADIOS &adios, const std::string &filename,
+                      int mpiRank, int mpiSize)
+    {
+        adios2::IO ioWrite = adios.DeclareIO("TestIOWrite");
+        ioWrite.SetEngine(engineName);
+        adios2::Engine engine = ioWrite.Open(filename, adios2::Mode::Write);
+        auto var = ioWrite.DefineVariable<int32_t>(
+            "var", {mpiSize * Nx}, {mpiRank * Nx}, {Nx});
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            auto d = GenerateData(static_cast<int>(step), mpiRank, mpiSize);
+            engine.BeginStep();
+            engine.Put(var, d.data());
+            engine.EndStep();
+        }
+        engine.Close();
+#if ADIOS2_USE_MPI
+        MPI_Barrier(MPI_COMM_WORLD);
+#endif
+    }
+};
+
+TEST_F(BPMetadataCacheSteps, SelectSteps)
+{
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    const std::string filename =
+        "MetadataCacheSteps" + std::to_string(mpiSize) + ".bp";
+    CreateOutput(adios, filename, mpiRank, mpiSize);
+
+    adios2::IO ioRead = adios.DeclareIO("TestIORead");
+    ioRead.SetEngine(engineName);
+    ioRead.SetParameter("SelectSteps", "1:n:2");
+    // keep the metadata of at most 2 steps installed
+    ioRead.SetParameter("MetadataCacheSteps", "2");
+    adios2::Engine engine_s =
+        ioRead.Open(filename, adios2::Mode::ReadRandomAccess);
+    EXPECT_TRUE(engine_s);
+
+    const std::vector<size_t> absoluteSteps = {1, 3, 5, 7, 9};
+    EXPECT_EQ(engine_s.Steps(), absoluteSteps.size());
+
+    adios2::Variable<int> var = ioRead.InquireVariable<int32_t>("var");
+    EXPECT_EQ(var.Steps(), absoluteSteps.size());
+
+    // out of order, so that evicted steps have to be installed again
+    for (const size_t step : {4, 0, 3, 1, 4, 2, 0})
+    {
+        const auto blocks = engine_s.BlocksInfo(var, step);
+        EXPECT_EQ(blocks.size(), static_cast<size_t>(mpiSize));
+        var.SetStepSelection(adios2::Box<size_t>(step, 1));
+        std::vector<int> res;
+        var.SetSelection({{Nx * mpiRank}, {Nx}});
+        engine_s.Get<int>(var, res, adios2::Mode::Sync);
+        int s = static_cast<int>(absoluteSteps[step]);
+        auto d = GenerateData(s, mpiRank, mpiSize);
+        EXPECT_EQ(res[0], d[0]);
+        EXPECT_EQ(res[Nx - 1], d[Nx - 1]);
+    }
+
+    engine_s.Close();
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -0,0 +1,150 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Test the "MetadataKeyframeInterval" parameter of the BP5 writer
+ */
+
+#include <cstdint>
+
+#include <array>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+constexpr std::size_t NSteps = 10;
+constexpr std::size_t Nx = 10;
+using DataArray = std::array<int32_t, Nx>;
+
+class BPMetadataKeyframe : public ::testing::Test
+{
+public:
+    BPMetadataKeyframe() = default;
+
+    DataArray GenerateData(int step, int rank, int size)
+    {
+        DataArray d;
+        d.fill(rank + 1 + step * size);
+        return d;
+    }
+};
+
+TEST_F(BPMetadataKeyframe, Interval)
+{
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    const std::string filename =
+        "MetadataKeyframeInterval" + std::to_string(mpiSize) + ".bp";
+    {
+        adios2::IO ioWrite = adios.DeclareIO("TestIOWrite");
+        ioWrite.SetEngine(engineName);
+        // keyframes at steps 0, 4 and 8, deltas in between
+        ioWrite.SetParameter("MetadataKeyframeInterval", "4");
+        adios2::Engine engine = ioWrite.Open(filename, adios2::Mode::Write);
+        auto var = ioWrite.DefineVariable<int32_t>(
+            "var", {mpiSize * Nx}, {mpiRank * Nx}, {Nx});
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            auto d = GenerateData(static_cast<int>(step), mpiRank, mpiSize);
+            engine.BeginStep();
+            engine.Put(var, d.data());
+            engine.EndStep();
+        }
+        engine.Close();
+    }
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    // delta encoded metadata needs BP minor version 3 readers
+    if (engineName == "BP5" && mpiRank == 0)
+    {
+        std::ifstream index(filename + "/md.idx", std::ios::binary);
+        index.seekg(38);
+        EXPECT_EQ(index.get(), 3);
+    }
+
+    // random access, the keyframes of the odd steps are not selected
+    {
+        adios2::IO ioRead = adios.DeclareIO("TestIORead");
+        ioRead.SetEngine(engineName);
+        ioRead.SetParameter("SelectSteps", "1:n:2");
+        adios2::Engine engine_s =
+            ioRead.Open(filename, adios2::Mode::ReadRandomAccess);
+        EXPECT_EQ(engine_s.Steps(), NSteps / 2);
+        adios2::Variable<int> var = ioRead.InquireVariable<int32_t>("var");
+        for (size_t step = 0; step < NSteps / 2; step++)
+        {
+            var.SetStepSelection(adios2::Box<size_t>(step, 1));
+            var.SetSelection({{Nx * mpiRank}, {Nx}});
+            std::vector<int> res;
+            engine_s.Get<int>(var, res, adios2::Mode::Sync);
+            auto d =
+                GenerateData(static_cast<int>(2 * step + 1), mpiRank, mpiSize);
+            EXPECT_EQ(res[0], d[0]);
+            EXPECT_EQ(res[Nx - 1], d[Nx - 1]);
+        }
+        engine_s.Close();
+    }
+
+    // streaming
+    {
+        adios2::IO ioRead = adios.DeclareIO("TestIOReadStream");
+        ioRead.SetEngine(engineName);
+        adios2::Engine engine_s = ioRead.Open(filename, adios2::Mode::Read);
+        size_t step = 0;
+        while (engine_s.BeginStep() == adios2::StepStatus::OK)
+        {
+            adios2::Variable<int> var = ioRead.InquireVariable<int32_t>("var");
+            var.SetSelection({{Nx * mpiRank}, {Nx}});
+            std::vector<int> res;
+            engine_s.Get<int>(var, res, adios2::Mode::Sync);
+            auto d = GenerateData(static_cast<int>(step), mpiRank, mpiSize);
+            EXPECT_EQ(res[0], d[0]);
+            // the minimum comes from rank 0
+            EXPECT_EQ(var.Min(), GenerateData(static_cast<int>(step), 0,
+                                              mpiSize)[0]);
+            engine_s.EndStep();
+            ++step;
+        }
+        EXPECT_EQ(step, NSteps);
+        engine_s.Close();
+    }
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -0,0 +1,116 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPPerformGetsAsync : public ::testing::Test
+{
+public:
+    BPPerformGetsAsync() = default;
+};
+
+TEST_F(BPPerformGetsAsync, Steps)
+{
+    const std::string fname("BPPerformGetsAsync.bp");
+    constexpr size_t NSteps = 4;
+    constexpr size_t Nx = 1000;
+
+    adios2::ADIOS adios;
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        auto var_a = io.DefineVariable<int32_t>("a", {Nx}, {0}, {Nx});
+        auto var_b = io.DefineVariable<double>("b", {Nx}, {0}, {Nx});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        std::vector<int32_t> a(Nx);
+        std::vector<double> b(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                a[i] = static_cast<int32_t>(step * Nx + i);
+                b[i] = -static_cast<double>(step * Nx + i);
+            }
+            bpWriter.BeginStep();
+            bpWriter.Put(var_a, a.data());
+            bpWriter.Put(var_b, b.data());
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+    std::vector<int32_t> a(Nx);
+    std::vector<double> b(Nx);
+    size_t step = 0;
+    while (bpReader.BeginStep() == adios2::StepStatus::OK)
+    {
+        auto var_a = io.InquireVariable<int32_t>("a");
+        auto var_b = io.InquireVariable<double>("b");
+        ASSERT_TRUE(var_a);
+        ASSERT_TRUE(var_b);
+
+        bpReader.Get(var_a, a.data());
+        auto done = bpReader.PerformGetsAsync();
+        // a Get waits for the reads in flight
+        bpReader.Get(var_b, b.data());
+        done.get();
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            EXPECT_EQ(a[i], static_cast<int32_t>(step * Nx + i));
+        }
+
+        // EndStep waits as well
+        done = bpReader.PerformGetsAsync();
+        bpReader.EndStep();
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            EXPECT_EQ(b[i], -static_cast<double>(step * Nx + i));
+        }
+        done.get();
+        ++step;
+    }
+    EXPECT_EQ(step, NSteps);
+    bpReader.Close();
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -0,0 +1,195 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Test the "PrefetchSteps" parameter of the BP5 reader
+ */
+#include <cstdint>
+
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPPrefetchSteps : public ::testing::Test
+{
+public:
+    BPPrefetchSteps() = default;
+};
+
+TEST_F(BPPrefetchSteps, ChangingLayout)
+{
+    const std::string fname("BPPrefetchSteps.bp");
+    constexpr size_t NSteps = 6;
+    constexpr size_t Nx = 1000;
+
+    adios2::ADIOS adios;
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        io.SetEngine(engineName);
+        auto var_a = io.DefineVariable<int32_t>("a", {Nx}, {0}, {Nx});
+        auto var_l = io.DefineVariable<double>("l", {}, {}, {1});
+        auto var_odd = io.DefineVariable<int32_t>("odd", {Nx}, {0}, {Nx});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        std::vector<int32_t> a(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                a[i] = static_cast<int32_t>(step * Nx + i);
+            }
+            // a block that grows every step moves the blocks behind it
+            std::vector<double> l(10 * (step + 1));
+            for (size_t i = 0; i < l.size(); ++i)
+            {
+                l[i] = -static_cast<double>(step * 100 + i);
+            }
+            var_l.SetSelection({{}, {l.size()}});
+            bpWriter.BeginStep();
+            if (step % 2)
+            {
+                bpWriter.Put(var_odd, a.data());
+            }
+            bpWriter.Put(var_l, l.data());
+            bpWriter.Put(var_a, a.data());
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine(engineName);
+    io.SetParameter("PrefetchSteps", "2");
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+    std::vector<int32_t> a;
+    std::vector<double> l;
+    size_t step = 0;
+    while (bpReader.BeginStep() == adios2::StepStatus::OK)
+    {
+        auto var_a = io.InquireVariable<int32_t>("a");
+        auto var_l = io.InquireVariable<double>("l");
+        ASSERT_TRUE(var_a);
+        ASSERT_TRUE(var_l);
+        // the same selection every step, a different one in step 3
+        const size_t start = (step == 3) ? 500 : 100;
+        var_a.SetSelection({{start}, {200}});
+        var_l.SetBlockSelection(0);
+        bpReader.Get(var_a, a);
+        bpReader.Get(var_l, l);
+        bpReader.EndStep();
+
+        ASSERT_EQ(a.size(), 200);
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            EXPECT_EQ(a[i], static_cast<int32_t>(step * Nx + start + i));
+        }
+        ASSERT_EQ(l.size(), 10 * (step + 1));
+        for (size_t i = 0; i < l.size(); ++i)
+        {
+            EXPECT_EQ(l[i], -static_cast<double>(step * 100 + i));
+        }
+        ++step;
+    }
+    EXPECT_EQ(step, NSteps);
+    bpReader.Close();
+}
+
+TEST_F(BPPrefetchSteps, SameLayout)
+{
+    const std::string fname("BPPrefetchStepsSame.bp");
+    constexpr size_t NSteps = 8;
+    constexpr size_t Nx = 1000;
+
+    adios2::ADIOS adios;
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        io.SetEngine(engineName);
+        auto var_a = io.DefineVariable<int32_t>("a", {Nx}, {0}, {Nx});
+        auto var_b = io.DefineVariable<double>("b", {Nx}, {0}, {Nx});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        std::vector<int32_t> a(Nx);
+        std::vector<double> b(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                a[i] = static_cast<int32_t>(step * Nx + i);
+                b[i] = -static_cast<double>(step * Nx + i);
+            }
+            bpWriter.BeginStep();
+            bpWriter.Put(var_a, a.data());
+            bpWriter.Put(var_b, b.data());
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine(engineName);
+    io.SetParameter("PrefetchSteps", "3");
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+    std::vector<int32_t> a;
+    std::vector<double> b;
+    size_t step = 0;
+    while (bpReader.BeginStep() == adios2::StepStatus::OK)
+    {
+        auto var_a = io.InquireVariable<int32_t>("a");
+        auto var_b = io.InquireVariable<double>("b");
+        ASSERT_TRUE(var_a);
+        ASSERT_TRUE(var_b);
+        var_a.SetSelection({{10}, {300}});
+        bpReader.Get(var_a, a);
+        if (step % 3 == 2)
+        {
+            // read more than the steps before, partly prefetched
+            bpReader.Get(var_b, b);
+        }
+        bpReader.EndStep();
+
+        ASSERT_EQ(a.size(), 300);
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            EXPECT_EQ(a[i], static_cast<int32_t>(step * Nx + 10 + i));
+        }
+        if (step % 3 == 2)
+        {
+            ASSERT_EQ(b.size(), Nx);
+            for (size_t i = 0; i < b.size(); ++i)
+            {
+                EXPECT_EQ(b[i], -static_cast<double>(step * Nx + i));
+            }
+        }
+        ++step;
+    }
+    EXPECT_EQ(step, NSteps);
+    bpReader.Close();
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -0,0 +1,194 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPReadPlan : public ::testing::Test
+{
+public:
+    BPReadPlan() = default;
+};
+
+namespace
+{
+
+constexpr size_t NSteps = 3;
+constexpr size_t Nx = 100;
+constexpr size_t NBlock = 10;
+
+double GlobalValue(const size_t step, const size_t i)
+{
+    return static_cast<double>(step * 1000 + i);
+}
+
+int32_t LocalValue(const size_t step, const size_t block, const size_t i)
+{
+    return static_cast<int32_t>(step * 100 + block * 10 + i);
+}
+
+void WriteFile(adios2::ADIOS &adios, const std::string &fname)
+{
+    adios2::IO io = adios.DeclareIO("WriteIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+
+    auto var_g = io.DefineVariable<double>("g", {Nx}, {0}, {Nx});
+    auto var_l = io.DefineVariable<int32_t>("l", {}, {}, {NBlock});
+
+    adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+    std::vector<double> g(Nx);
+    std::vector<int32_t> l0(NBlock), l1(NBlock);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            g[i] = GlobalValue(step, i);
+        }
+        for (size_t i = 0; i < NBlock; ++i)
+        {
+            l0[i] = LocalValue(step, 0, i);
+            l1[i] = LocalValue(step, 1, i);
+        }
+        bpWriter.BeginStep();
+        bpWriter.Put(var_g, g.data());
+        bpWriter.Put(var_l, l0.data());
+        bpWriter.Put(var_l, l1.data());
+        bpWriter.EndStep();
+    }
+    bpWriter.Close();
+}
+
+} // end empty namespace
+
+TEST_F(BPReadPlan, Selections)
+{
+    const std::string fname("BPReadPlan.bp");
+    adios2::ADIOS adios;
+    WriteFile(adios, fname);
+
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+    auto var_g = io.InquireVariable<double>("g");
+    auto var_l = io.InquireVariable<int32_t>("l");
+    ASSERT_TRUE(var_g);
+    ASSERT_TRUE(var_l);
+
+    // overlapping and identical selections of the same variable, several
+    // steps and blocks, added out of order
+    std::vector<double> all(NSteps * Nx), first(20), overlap(20), again(20);
+    std::vector<int32_t> block1(NBlock), block0(2 * NBlock);
+    adios2::ReadPlan plan;
+    plan.AddBlock(var_l, 1, block1.data(), {2, 1});
+    plan.Add(var_g, first.data(), {{10}, {20}}, {1, 1});
+    plan.Add(var_g, all.data(), {{0}, {Nx}}, {0, NSteps});
+    plan.Add(var_g, overlap.data(), {{20}, {20}}, {1, 1});
+    plan.AddBlock(var_l, 0, block0.data(), {0, 2});
+    plan.Add(var_g, again.data(), {{10}, {20}}, {1, 1});
+    // the selection of the variable when added, not when executed
+    std::vector<double> kept(5);
+    var_g.SetSelection({{30}, {5}});
+    var_g.SetStepSelection({2, 1});
+    plan.Add(var_g, kept.data());
+    EXPECT_EQ(plan.Size(), 7);
+
+    var_g.SetSelection({{50}, {7}});
+    var_g.SetStepSelection({1, 1});
+    bpReader.Get(plan);
+
+    // the selections are restored
+    EXPECT_EQ(var_g.Start(), adios2::Dims{50});
+    EXPECT_EQ(var_g.Count(), adios2::Dims{7});
+    std::vector<double> restored;
+    bpReader.Get(var_g, restored, adios2::Mode::Sync);
+    ASSERT_EQ(restored.size(), 7);
+    for (size_t i = 0; i < restored.size(); ++i)
+    {
+        EXPECT_EQ(restored[i], GlobalValue(1, 50 + i));
+    }
+    for (size_t i = 0; i < kept.size(); ++i)
+    {
+        EXPECT_EQ(kept[i], GlobalValue(2, 30 + i));
+    }
+
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            EXPECT_EQ(all[step * Nx + i], GlobalValue(step, i));
+        }
+    }
+    for (size_t i = 0; i < 20; ++i)
+    {
+        EXPECT_EQ(first[i], GlobalValue(1, 10 + i));
+        EXPECT_EQ(again[i], GlobalValue(1, 10 + i));
+        EXPECT_EQ(overlap[i], GlobalValue(1, 20 + i));
+    }
+    for (size_t i = 0; i < NBlock; ++i)
+    {
+        EXPECT_EQ(block1[i], LocalValue(2, 1, i));
+        EXPECT_EQ(block0[i], LocalValue(0, 0, i));
+        EXPECT_EQ(block0[NBlock + i], LocalValue(1, 0, i));
+    }
+
+    // the same plan again, asynchronously
+    std::fill(all.begin(), all.end(), 0.);
+    std::fill(again.begin(), again.end(), 0.);
+    std::fill(kept.begin(), kept.end(), 0.);
+    auto done = bpReader.GetAsync(plan);
+    EXPECT_EQ(var_g.Start(), adios2::Dims{50});
+    done.get();
+    for (size_t i = 0; i < kept.size(); ++i)
+    {
+        EXPECT_EQ(kept[i], GlobalValue(2, 30 + i));
+    }
+    for (size_t i = 0; i < NSteps * Nx; ++i)
+    {
+        EXPECT_EQ(all[i], GlobalValue(i / Nx, i % Nx));
+    }
+    for (size_t i = 0; i < 20; ++i)
+    {
+        EXPECT_EQ(again[i], GlobalValue(1, 10 + i));
+    }
+
+    plan.Clear();
+    EXPECT_EQ(plan.Size(), 0);
+    bpReader.Close();
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -0,0 +1,143 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Test the "Threads" parameter of the BP5 writer, which splits large copies
+ * into the buffer over threads
+ */
+#include <cstdint>
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+// BufferVType, Threads
+using ParamType = std::tuple<std::string, std::string>;
+
+class BPThreads : public ::testing::TestWithParam<ParamType>
+{
+public:
+    BPThreads() = default;
+};
+
+TEST_P(BPThreads, SyncAndDeferred)
+{
+    const std::string bufferType = std::get<0>(GetParam());
+    const std::string threads = std::get<1>(GetParam());
+    const std::string fname("BPThreads_" + bufferType + "_" + threads + ".bp");
+    constexpr size_t NSteps = 3;
+    // a few MB, so the copies are split, and an odd size for the remainder
+    constexpr size_t Nx = 3 * 1024 * 1024 / sizeof(double) + 7;
+    constexpr size_t NSmall = 100;
+
+    auto lf_Value = [](size_t var, size_t step, size_t i) {
+        return static_cast<double>(var * 1000000000 + step * 10000000 + i);
+    };
+
+    adios2::ADIOS adios;
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        io.SetEngine(engineName);
+        io.SetParameters({{"BufferVType", bufferType}, {"Threads", threads}});
+        auto var_s = io.DefineVariable<double>("sync", {Nx}, {0}, {Nx});
+        auto var_d = io.DefineVariable<double>("deferred", {Nx}, {0}, {Nx});
+        auto var_small =
+            io.DefineVariable<double>("small", {NSmall}, {0}, {NSmall});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        std::vector<double> s(Nx), d(Nx), small(NSmall);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                s[i] = lf_Value(0, step, i);
+                d[i] = lf_Value(1, step, i);
+            }
+            for (size_t i = 0; i < NSmall; ++i)
+            {
+                small[i] = lf_Value(2, step, i);
+            }
+            bpWriter.BeginStep();
+            bpWriter.Put(var_small, small.data(), adios2::Mode::Sync);
+            bpWriter.Put(var_s, s.data(), adios2::Mode::Sync);
+            bpWriter.Put(var_d, d.data());
+            // copies the deferred block into the buffer
+            bpWriter.PerformPuts();
+            std::fill(s.begin(), s.end(), -1.0);
+            std::fill(d.begin(), d.end(), -1.0);
+            std::fill(small.begin(), small.end(), -1.0);
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine(engineName);
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+    size_t step = 0;
+    std::vector<double> s, d, small;
+    while (bpReader.BeginStep() == adios2::StepStatus::OK)
+    {
+        auto var_s = io.InquireVariable<double>("sync");
+        auto var_d = io.InquireVariable<double>("deferred");
+        auto var_small = io.InquireVariable<double>("small");
+        ASSERT_TRUE(var_s);
+        ASSERT_TRUE(var_d);
+        ASSERT_TRUE(var_small);
+        bpReader.Get(var_s, s);
+        bpReader.Get(var_d, d);
+        bpReader.Get(var_small, small);
+        bpReader.EndStep();
+
+        ASSERT_EQ(s.size(), Nx);
+        ASSERT_EQ(d.size(), Nx);
+        ASSERT_EQ(small.size(), NSmall);
+        size_t wrong = 0;
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            wrong += (s[i] != lf_Value(0, step, i));
+            wrong += (d[i] != lf_Value(1, step, i));
+        }
+        for (size_t i = 0; i < NSmall; ++i)
+        {
+            wrong += (small[i] != lf_Value(2, step, i));
+        }
+        EXPECT_EQ(wrong, 0) << "in step " << step;
+        ++step;
+    }
+    EXPECT_EQ(step, NSteps);
+    bpReader.Close();
+}
+
+INSTANTIATE_TEST_SUITE_P(BufferAndThreads, BPThreads,
+                         ::testing::Combine(::testing::Values("malloc",
+                                                              "chunk"),
+                                            ::testing::Values("1", "4")));
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -9,6 +9,7 @@
  */
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include <iostream>
 #include <stdexcept>
@@ -115,6 +116,97 @@ TEST_F(BPWriteReadAttributeTestMultirank, ADIOS2BPWriteReadArrayTypes)
     }
 }
 
+// BP5 gathers metadata node by node when asked to, other engines ignore it
+TEST_F(BPWriteReadAttributeTestMultirank, ADIOS2BPWriteReadTwoLevelMetadata)
+{
+    const std::string fName = "foo" + std::string(&adios2::PathSeparator, 1) +
+                              "ADIOS2BPWriteReadTwoLevelMetadata.bp";
+
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    // the same variable on all ranks and one variable per rank
+    std::string varpath = "rank" + std::to_string(mpiRank) +
+                          std::string(&adios2::PathSeparator, 1) + "value";
+    std::string attrpath =
+        varpath + std::string(&adios2::PathSeparator, 1) + "description";
+    const size_t NSteps = 3;
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameter("TwoLevelMetadata", "true");
+
+        auto all = io.DefineVariable<int>(
+            "all", {static_cast<size_t>(mpiSize)},
+            {static_cast<size_t>(mpiRank)}, {1});
+        auto var = io.DefineVariable<int>(varpath);
+        io.DefineAttribute<std::string>(attrpath,
+                                        "rank " + std::to_string(mpiRank));
+
+        adios2::Engine engine = io.Open(fName, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            const int value = static_cast<int>(step) * mpiSize + mpiRank;
+            engine.BeginStep();
+            engine.Put(all, value);
+            engine.Put(var, value);
+            engine.EndStep();
+        }
+        engine.Close();
+    }
+    {
+        adios2::IO ioRead = adios.DeclareIO("ioRead");
+        if (!engineName.empty())
+        {
+            ioRead.SetEngine(engineName);
+        }
+
+        adios2::Engine bpRead =
+            ioRead.Open(fName, adios2::Mode::ReadRandomAccess);
+        EXPECT_EQ(bpRead.Steps(), NSteps);
+
+        auto all = ioRead.InquireVariable<int>("all");
+        ASSERT_TRUE(all);
+        EXPECT_EQ(all.Shape()[0], static_cast<size_t>(mpiSize));
+        auto var = ioRead.InquireVariable<int>(varpath);
+        ASSERT_TRUE(var);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            std::vector<int> allValues;
+            int value = -1;
+            all.SetStepSelection({step, 1});
+            var.SetStepSelection({step, 1});
+            bpRead.Get(all, allValues);
+            bpRead.Get(var, &value);
+            bpRead.PerformGets();
+            ASSERT_EQ(allValues.size(), static_cast<size_t>(mpiSize));
+            for (int r = 0; r < mpiSize; ++r)
+            {
+                EXPECT_EQ(allValues[r], static_cast<int>(step) * mpiSize + r);
+            }
+            EXPECT_EQ(value, static_cast<int>(step) * mpiSize + mpiRank);
+        }
+
+        auto attr = ioRead.InquireAttribute<std::string>(attrpath);
+        ASSERT_TRUE(attr);
+        EXPECT_EQ(attr.Data()[0], "rank " + std::to_string(mpiRank));
+
+        bpRead.Close();
+    }
+}
+
 //******************************************************************************
 // main
 //******************************************************************************
@@ -0,0 +1,198 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Test the "DecompressedCacheSize" parameter of the BP5 reader
+ */
+#include <cstdint>
+
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPDecompressedCache : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPDecompressedCache() = default;
+};
+
+namespace
+{
+
+constexpr size_t NSteps = 3;
+constexpr size_t Nx = 40; // rows, 2 blocks of Nx/2
+constexpr size_t Ny = 60; // columns, 3 blocks of Ny/3
+
+double Value(size_t step, size_t i, size_t j)
+{
+    return static_cast<double>(step * 10000 + i * 100 + j);
+}
+
+void WriteFile(adios2::ADIOS &adios, const std::string &fname)
+{
+    adios2::IO io = adios.DeclareIO("WriteIO");
+    io.SetEngine(engineName);
+    auto var = io.DefineVariable<double>("a", {Nx, Ny}, {0, 0},
+                                         {Nx / 2, Ny / 3});
+    adios2::Operator op =
+        adios.DefineOperator("BZIP2Compressor", adios2::ops::LosslessBZIP2);
+    var.AddOperation(op, {});
+
+    adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+    std::vector<double> block(Nx / 2 * Ny / 3);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        bpWriter.BeginStep();
+        for (size_t bi = 0; bi < 2; ++bi)
+        {
+            for (size_t bj = 0; bj < 3; ++bj)
+            {
+                for (size_t i = 0; i < Nx / 2; ++i)
+                {
+                    for (size_t j = 0; j < Ny / 3; ++j)
+                    {
+                        block[i * Ny / 3 + j] =
+                            Value(step, bi * Nx / 2 + i, bj * Ny / 3 + j);
+                    }
+                }
+                var.SetSelection(
+                    {{bi * Nx / 2, bj * Ny / 3}, {Nx / 2, Ny / 3}});
+                bpWriter.Put(var, block.data(), adios2::Mode::Sync);
+            }
+        }
+        bpWriter.EndStep();
+    }
+    bpWriter.Close();
+}
+
+void CheckSlice(const std::vector<double> &data, size_t step,
+                const adios2::Box<adios2::Dims> &sel)
+{
+    ASSERT_EQ(data.size(), sel.second[0] * sel.second[1]);
+    for (size_t i = 0; i < sel.second[0]; ++i)
+    {
+        for (size_t j = 0; j < sel.second[1]; ++j)
+        {
+            EXPECT_EQ(data[i * sel.second[1] + j],
+                      Value(step, sel.first[0] + i, sel.first[1] + j));
+        }
+    }
+}
+
+// overlapping slices that pan across the blocks and come back
+const std::vector<adios2::Box<adios2::Dims>> Slices = {
+    {{5, 5}, {10, 10}},  {{5, 15}, {10, 10}}, {{15, 15}, {10, 30}},
+    {{5, 5}, {10, 10}},  {{0, 0}, {Nx, Ny}},  {{30, 50}, {10, 10}},
+    {{15, 15}, {10, 30}}};
+
+} // end empty namespace
+
+TEST_P(BPDecompressedCache, RandomAccess)
+{
+    const std::string fname("BPDecompressedCacheRA_" + GetParam() + ".bp");
+    adios2::ADIOS adios;
+    WriteFile(adios, fname);
+
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine(engineName);
+    io.SetParameter("DecompressedCacheSize", GetParam());
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+    auto var = io.InquireVariable<double>("a");
+    ASSERT_TRUE(var);
+
+    std::vector<double> data;
+    for (size_t pass = 0; pass < 2; ++pass)
+    {
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (const auto &sel : Slices)
+            {
+                var.SetStepSelection({step, 1});
+                var.SetSelection(sel);
+                bpReader.Get(var, data, adios2::Mode::Sync);
+                CheckSlice(data, step, sel);
+            }
+        }
+    }
+
+    // several slices of several steps in one PerformGets
+    std::vector<std::vector<double>> all(NSteps * Slices.size());
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        for (size_t s = 0; s < Slices.size(); ++s)
+        {
+            var.SetStepSelection({step, 1});
+            var.SetSelection(Slices[s]);
+            bpReader.Get(var, all[step * Slices.size() + s]);
+        }
+    }
+    bpReader.PerformGets();
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        for (size_t s = 0; s < Slices.size(); ++s)
+        {
+            CheckSlice(all[step * Slices.size() + s], step, Slices[s]);
+        }
+    }
+    bpReader.Close();
+}
+
+TEST_P(BPDecompressedCache, Streaming)
+{
+    const std::string fname("BPDecompressedCacheST_" + GetParam() + ".bp");
+    adios2::ADIOS adios;
+    WriteFile(adios, fname);
+
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine(engineName);
+    io.SetParameter("DecompressedCacheSize", GetParam());
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+    std::vector<double> data;
+    size_t step = 0;
+    while (bpReader.BeginStep() == adios2::StepStatus::OK)
+    {
+        auto var = io.InquireVariable<double>("a");
+        ASSERT_TRUE(var);
+        for (const auto &sel : Slices)
+        {
+            var.SetSelection(sel);
+            bpReader.Get(var, data, adios2::Mode::Sync);
+            CheckSlice(data, step, sel);
+        }
+        bpReader.EndStep();
+        ++step;
+    }
+    EXPECT_EQ(step, NSteps);
+    bpReader.Close();
+}
+
+// off, smaller than one block, a few blocks, everything
+INSTANTIATE_TEST_SUITE_P(CacheSize, BPDecompressedCache,
+                         ::testing::Values("0", "1000", "20000", "16MB"));
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -172,7 +172,8 @@ void Reader(const Dims &shape, const Dims &start, const Dims &count,
 
 void Writer(const Dims &shape, const Dims &start, const Dims &count,
             const size_t rows, const adios2::Params &engineParams,
-            const std::string &name)
+            const std::string &name,
+            const std::vector<adios2::Params> &routes = {})
 {
     size_t datasize = 1;
     for (const auto &i : count)
@@ -188,6 +189,10 @@ void Writer(const Dims &shape, const Dims &start, const Dims &count,
     io.SetEngine("mhs");
     io.SetParameters(engineParams);
     io.AddTransport("sirius", {{"variable", "bpFloats"}});
+    for (const auto &route : routes)
+    {
+        io.AddTransport("route", route);
+    }
     std::vector<char> myChars(datasize);
     std::vector<unsigned char> myUChars(datasize);
     std::vector<short> myShorts(datasize);
@@ -274,6 +279,56 @@ TEST_F(MhsEngineTest, TestMhsSingleRank)
 #endif
 }
 
+TEST_F(MhsEngineTest, TestMhsRoutedTiers)
+{
+    std::string filename = "TestMhsRoutedTiers";
+    adios2::Params engineParams = {{"Verbose", "0"},
+                                   {"Tiers", "2"},
+                                   {"AsyncTiers", "true"},
+                                   {"Tier1.Engine", "BP4"},
+                                   {"Tier1.Path", "TestMhsRoutedTiers.pfs"}};
+
+    size_t rows = 100;
+    Dims shape = {rows, 1, 128};
+    Dims start = {0, 0, 0};
+    Dims count = {1, 1, 128};
+
+    Writer(shape, start, count, rows, engineParams, filename,
+           {{{"variable", "bpDoubles"}, {"tiers", "0,1"}},
+            {{"variable", "bpInts"}, {"tiers", "0,1"}}});
+
+    Reader(shape, start, count, rows, engineParams, filename);
+
+    // the routed copies are complete on their own in tier 1
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("tier1");
+    io.SetEngine("BP4");
+    adios2::Engine tierEngine = io.Open(
+        "TestMhsRoutedTiers.pfs/" + filename + ".tier1", adios2::Mode::Read);
+    tierEngine.BeginStep();
+    auto bpDoubles = io.InquireVariable<double>("bpDoubles");
+    auto bpInts = io.InquireVariable<int>("bpInts");
+    ASSERT_TRUE(bpDoubles);
+    ASSERT_TRUE(bpInts);
+    ASSERT_FALSE(io.InquireVariable<short>("bpShorts"));
+    std::vector<double> myDoubles;
+    std::vector<int> myInts;
+    tierEngine.Get(bpDoubles, myDoubles, adios2::Mode::Sync);
+    tierEngine.Get(bpInts, myInts, adios2::Mode::Sync);
+    VerifyData(myDoubles.data(), rows, shape);
+    VerifyData(myInts.data(), rows, shape);
+    tierEngine.EndStep();
+    tierEngine.Close();
+
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+
 int main(int argc, char **argv)
 {
 #if ADIOS2_USE_MPI
@@ -2,11 +2,14 @@
  * Distributed under the OSI-approved Apache License, Version 2.0.  See
  * accompanying file Copyright.txt for details.
  */
+#include <algorithm> //std::sort
+#include <chrono>
 #include <cstdint>
 #include <cstring>
 
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <numeric> //std::iota
 #include <stdexcept>
 
@@ -46,6 +49,59 @@ void WriteXmlQuery1D(const std::string &queryFile, const std::string &ioName,
     file.close();
 }
 
+void WriteXmlQueryRange(const std::string &queryFile, const std::string &ioName,
+                        const std::string &varName, size_t count, double lo,
+                        double hi)
+{
+    std::ofstream file(queryFile.c_str());
+    file << "<adios-query>" << std::endl;
+    file << " <io name=\"" << ioName << "\">" << std::endl;
+    file << "   <var name=\"" << varName << "\">" << std::endl;
+    file << "      <boundingbox  start=\"0\" count=\"" << count << "\"/>"
+         << std::endl;
+    file << "       <op value=\"AND\">" << std::endl;
+    file << "         <range  compare=\"GT\" value=\"" << lo << "\"/>"
+         << std::endl;
+    file << "         <range  compare=\"LT\" value=\"" << hi << "\"/>"
+         << std::endl;
+    file << "       </op>" << std::endl;
+    file << "   </var>" << std::endl;
+    file << " </io>" << std::endl;
+    file << "</adios-query>" << std::endl;
+    file.close();
+}
+
+void WriteXmlQueryOverlap(const std::string &queryFile,
+                          const std::string &ioName,
+                          const std::string &varName)
+{
+    // two partially overlapping bounding boxes joined by OR
+    std::ofstream file(queryFile.c_str());
+    file << "<adios-query>" << std::endl;
+    file << " <io name=\"" << ioName << "\">" << std::endl;
+    const char *tags[] = {"A", "B"};
+    const char *starts[] = {"0", "40"};
+    for (size_t t = 0; t < 2; ++t)
+    {
+        file << "  <tag name=\"" << tags[t] << "\">" << std::endl;
+        file << "   <var name=\"" << varName << "\">" << std::endl;
+        file << "      <boundingbox  start=\"" << starts[t]
+             << "\" count=\"60\"/>" << std::endl;
+        file << "       <op value=\"AND\">" << std::endl;
+        file << "         <range  compare=\"GT\" value=\"50\"/>" << std::endl;
+        file << "       </op>" << std::endl;
+        file << "   </var>" << std::endl;
+        file << "  </tag>" << std::endl;
+    }
+    file << "  <query op=\"OR\">" << std::endl;
+    file << "    <A/>" << std::endl;
+    file << "    <B/>" << std::endl;
+    file << "  </query>" << std::endl;
+    file << " </io>" << std::endl;
+    file << "</adios-query>" << std::endl;
+    file.close();
+}
+
 void LoadTestData(QueryTestData &input, int step, int rank, int dataSize)
 {
     input.m_IntData.clear();
@@ -71,6 +127,12 @@ public:
                         const std::string &engineName);
     void QueryIntVar(const std::string &fname, adios2::ADIOS &adios,
                      const std::string &engineName);
+    void QueryAllSteps(const std::string &fname, adios2::ADIOS &adios,
+                       const std::string &engineName);
+    void QueryValues(const std::string &fname, adios2::ADIOS &adios,
+                     const std::string &engineName);
+    void QueryOffsetBlocks(adios2::ADIOS &adios, const std::string &engineName);
+    void QueryOverlapInt8(adios2::ADIOS &adios, const std::string &engineName);
 
     QueryTestData m_TestData;
 
@@ -100,10 +162,11 @@ void BPQueryTest::QueryIntVar(const std::string &fname, adios2::ADIOS &adios,
     std::string queryFile = "./" + ioName + "test.xml"; //"./test.xml";
     std::cout << ioName << std::endl;
     WriteXmlQuery1D(queryFile, ioName, "intV");
-    adios2::QueryWorker w = adios2::QueryWorker(queryFile, bpReader);
+    // created in the first step, BP5 defines variables only inside a step
+    std::unique_ptr<adios2::QueryWorker> w;
 
     std::vector<size_t> rr;
-    if (engineName.compare("BP4") == 0)
+    if ((engineName.compare("BP4") == 0) || (engineName.compare("BP5") == 0))
         rr = {9, 9, 9};
     else
         rr = {1, 1, 1};
@@ -112,7 +175,11 @@ void BPQueryTest::QueryIntVar(const std::string &fname, adios2::ADIOS &adios,
     {
         std::vector<adios2::Box<adios2::Dims>> touched_blocks;
         adios2::Box<adios2::Dims> empty;
-        w.GetResultCoverage(empty, touched_blocks);
+        if (!w)
+        {
+            w.reset(new adios2::QueryWorker(queryFile, bpReader));
+        }
+        w->GetResultCoverage(empty, touched_blocks);
         ASSERT_EQ(touched_blocks.size(), rr[bpReader.CurrentStep()]);
         bpReader.EndStep();
     }
@@ -137,10 +204,11 @@ void BPQueryTest::QueryDoubleVar(const std::string &fname, adios2::ADIOS &adios,
     // std::string queryFile = "./.test.xml";
     std::string queryFile = "./" + ioName + "test.xml";
     WriteXmlQuery1D(queryFile, ioName, "doubleV");
-    adios2::QueryWorker w = adios2::QueryWorker(queryFile, bpReader);
+    // created in the first step, BP5 defines variables only inside a step
+    std::unique_ptr<adios2::QueryWorker> w;
 
     std::vector<size_t> rr; //= {0,9,9};
-    if (engineName.compare("BP4") == 0)
+    if ((engineName.compare("BP4") == 0) || (engineName.compare("BP5") == 0))
         rr = {0, 9, 9};
     else
         rr = {0, 1, 1};
@@ -148,13 +216,230 @@ void BPQueryTest::QueryDoubleVar(const std::string &fname, adios2::ADIOS &adios,
     {
         std::vector<adios2::Box<adios2::Dims>> touched_blocks;
         adios2::Box<adios2::Dims> empty;
-        w.GetResultCoverage(empty, touched_blocks);
+        if (!w)
+        {
+            w.reset(new adios2::QueryWorker(queryFile, bpReader));
+        }
+        w->GetResultCoverage(empty, touched_blocks);
         ASSERT_EQ(touched_blocks.size(), rr[bpReader.CurrentStep()]);
         bpReader.EndStep();
     }
     bpReader.Close();
 }
 
+void BPQueryTest::QueryAllSteps(const std::string &fname, adios2::ADIOS &adios,
+                                const std::string &engineName)
+{
+    std::string ioName = "IOQueryTestAllSteps" + engineName;
+    adios2::IO io = adios.DeclareIO(ioName.c_str());
+    io.SetEngine(engineName);
+
+    // random access, all steps are visible without BeginStep
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+    EXPECT_EQ(bpReader.Steps(), NSteps);
+
+    std::string queryFile = "./" + ioName + "test.xml";
+    WriteXmlQuery1D(queryFile, ioName, "doubleV");
+    adios2::QueryWorker w(queryFile, bpReader);
+
+    const std::vector<size_t> rr = {0, 9, 9};
+    adios2::Box<adios2::Dims> empty;
+    std::vector<std::vector<adios2::Box<adios2::Dims>>> serial, threaded;
+
+    auto tStart = std::chrono::steady_clock::now();
+    w.GetResultCoverage(empty, 0, NSteps, serial, 1);
+    auto tSerial = std::chrono::steady_clock::now();
+    w.GetResultCoverage(empty, 0, NSteps, threaded, 4);
+    auto tThreaded = std::chrono::steady_clock::now();
+
+    // timings go to the test report (--gtest_output=xml)
+    RecordProperty("SerialMicroseconds",
+                   static_cast<int>(std::chrono::duration<double, std::micro>(
+                                        tSerial - tStart)
+                                        .count()));
+    RecordProperty("ThreadedMicroseconds",
+                   static_cast<int>(std::chrono::duration<double, std::micro>(
+                                        tThreaded - tSerial)
+                                        .count()));
+
+    ASSERT_EQ(serial.size(), NSteps);
+    ASSERT_EQ(threaded.size(), NSteps);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        ASSERT_EQ(serial[step].size(), rr[step]);
+        ASSERT_EQ(threaded[step].size(), rr[step]);
+        for (size_t i = 0; i < serial[step].size(); ++i)
+        {
+            EXPECT_EQ(serial[step][i], threaded[step][i]);
+        }
+    }
+
+    // a range past the last step is clipped
+    w.GetResultCoverage(empty, 1, NSteps, threaded, 2);
+    ASSERT_EQ(threaded.size(), NSteps - 1);
+    EXPECT_EQ(threaded[0].size(), rr[1]);
+    bpReader.Close();
+}
+
+void BPQueryTest::QueryValues(const std::string &fname, adios2::ADIOS &adios,
+                              const std::string &engineName)
+{
+    std::string ioName = "IOQueryTestValues" + engineName;
+    adios2::IO io = adios.DeclareIO(ioName.c_str());
+    io.SetEngine(engineName);
+
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+    std::string queryFile = "./" + ioName + "test.xml";
+    WriteXmlQuery1D(queryFile, ioName, "doubleV");
+    std::unique_ptr<adios2::QueryWorker> w;
+
+    while (bpReader.BeginStep() == adios2::StepStatus::OK)
+    {
+        const size_t step = bpReader.CurrentStep();
+        if (!w)
+        {
+            w.reset(new adios2::QueryWorker(queryFile, bpReader));
+        }
+
+        // same predicate and bounding box as WriteXmlQuery1D
+        LoadTestData(m_TestData, static_cast<int>(step), 0,
+                     static_cast<int>(Nx));
+        std::vector<size_t> expectedIndex;
+        std::vector<double> expectedValues;
+        for (size_t i = 5; i < 85; ++i)
+        {
+            const double v = m_TestData.m_DoubleData[i];
+            if ((v > 6.6) || (v < -0.17) || ((v < 2.9) && (v > 2.8)))
+            {
+                expectedIndex.push_back(i);
+                expectedValues.push_back(v);
+            }
+        }
+
+        std::vector<adios2::Box<adios2::Dims>> touched_blocks;
+        std::vector<std::vector<size_t>> hits;
+        std::vector<double> values;
+        w->GetResultValues(touched_blocks, hits, values);
+
+        ASSERT_EQ(touched_blocks.size(), hits.size());
+        std::vector<size_t> foundIndex;
+        for (size_t b = 0; b < touched_blocks.size(); ++b)
+        {
+            ASSERT_FALSE(hits[b].empty());
+            for (const size_t offset : hits[b])
+            {
+                foundIndex.push_back(touched_blocks[b].first[0] + offset);
+            }
+        }
+        EXPECT_EQ(foundIndex, expectedIndex);
+        EXPECT_EQ(values, expectedValues);
+
+        std::vector<adios2::Box<adios2::Dims>> hitBlocks;
+        std::vector<std::vector<size_t>> hitsOnly;
+        w->GetResultHits(hitBlocks, hitsOnly);
+        EXPECT_EQ(hitBlocks, touched_blocks);
+        EXPECT_EQ(hitsOnly, hits);
+        bpReader.EndStep();
+    }
+    bpReader.Close();
+}
+
+void BPQueryTest::QueryOffsetBlocks(adios2::ADIOS &adios,
+                                    const std::string &engineName)
+{
+    // two blocks side by side, the value of an element is its global index
+    const std::string fname(engineName + "QueryOffsetBlocks.bp");
+    {
+        adios2::IO io = adios.DeclareIO("IOQueryOffsetWriter" + engineName);
+        io.SetEngine(engineName);
+        io.SetParameters("StatsLevel=1,StatsBlockSize=10");
+        auto var = io.DefineVariable<double>("v", {2 * Nx}, {0}, {Nx});
+        std::vector<double> left(Nx), right(Nx);
+        std::iota(left.begin(), left.end(), 0.);
+        std::iota(right.begin(), right.end(), static_cast<double>(Nx));
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        bpWriter.BeginStep();
+        var.SetSelection({{0}, {Nx}});
+        bpWriter.Put(var, left.data());
+        var.SetSelection({{Nx}, {Nx}});
+        bpWriter.Put(var, right.data());
+        bpWriter.EndStep();
+        bpWriter.Close();
+    }
+
+    std::string ioName = "IOQueryOffsetReader" + engineName;
+    adios2::IO io = adios.DeclareIO(ioName);
+    io.SetEngine(engineName);
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+    std::string queryFile = "./" + ioName + "test.xml";
+    WriteXmlQueryRange(queryFile, ioName, "v", 2 * Nx, Nx + 52.5, Nx + 67.5);
+
+    ASSERT_EQ(bpReader.BeginStep(), adios2::StepStatus::OK);
+    adios2::QueryWorker w(queryFile, bpReader);
+    adios2::Box<adios2::Dims> empty;
+    std::vector<adios2::Box<adios2::Dims>> touched_blocks;
+    w.GetResultCoverage(empty, touched_blocks);
+
+    // sub-blocks of the second block are reported in global coordinates
+    const std::vector<adios2::Box<adios2::Dims>> expected = {
+        {{Nx + 50}, {10}}, {{Nx + 60}, {10}}};
+    EXPECT_EQ(touched_blocks, expected);
+    bpReader.EndStep();
+    bpReader.Close();
+}
+
+void BPQueryTest::QueryOverlapInt8(adios2::ADIOS &adios,
+                                   const std::string &engineName)
+{
+    // the value of an element is its index
+    const std::string fname(engineName + "QueryOverlapInt8.bp");
+    {
+        adios2::IO io = adios.DeclareIO("IOQueryOverlapWriter" + engineName);
+        io.SetEngine(engineName);
+        auto var = io.DefineVariable<int8_t>("c", {Nx}, {0}, {Nx});
+        std::vector<int8_t> c(Nx);
+        std::iota(c.begin(), c.end(), static_cast<int8_t>(0));
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        bpWriter.BeginStep();
+        bpWriter.Put(var, c.data());
+        bpWriter.EndStep();
+        bpWriter.Close();
+    }
+
+    std::string ioName = "IOQueryOverlapReader" + engineName;
+    adios2::IO io = adios.DeclareIO(ioName);
+    io.SetEngine(engineName);
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+    std::string queryFile = "./" + ioName + "test.xml";
+    WriteXmlQueryOverlap(queryFile, ioName, "c");
+
+    ASSERT_EQ(bpReader.BeginStep(), adios2::StepStatus::OK);
+    adios2::QueryWorker w(queryFile, bpReader);
+    std::vector<adios2::Box<adios2::Dims>> touched_blocks;
+    std::vector<std::vector<size_t>> hits;
+    w.GetResultHits(touched_blocks, hits);
+
+    // "50" is compared as a number, and elements in both boxes are reported
+    // once
+    std::vector<size_t> foundIndex;
+    for (size_t b = 0; b < touched_blocks.size(); ++b)
+    {
+        for (const size_t offset : hits[b])
+        {
+            foundIndex.push_back(touched_blocks[b].first[0] + offset);
+        }
+    }
+    std::sort(foundIndex.begin(), foundIndex.end());
+    std::vector<size_t> expectedIndex(Nx - 51);
+    std::iota(expectedIndex.begin(), expectedIndex.end(), 51);
+    EXPECT_EQ(foundIndex, expectedIndex);
+    bpReader.EndStep();
+    bpReader.Close();
+}
+
 void BPQueryTest::WriteFile(const std::string &fname, adios2::ADIOS &adios,
                             const std::string &engineName)
 {
@@ -200,6 +485,10 @@ void BPQueryTest::WriteFile(const std::string &fname, adios2::ADIOS &adios,
             io.SetParameters("statslevel=1");
             io.SetParameters("statsblocksize=10");
         }
+        else if (engineName.compare("BP5") == 0)
+        {
+            io.SetParameters("StatsBlockSize=10");
+        }
         io.AddTransport("file");
 
         // QUESTION: It seems that BPFilterWriter cannot overwrite existing
@@ -285,8 +574,40 @@ TEST_F(BPQueryTest, BP4)
     {
         QueryDoubleVar(fname, adios, engineName);
         QueryIntVar(fname, adios, engineName);
+        QueryAllSteps(fname, adios, engineName);
+        QueryValues(fname, adios, engineName);
+        QueryOffsetBlocks(adios, engineName);
+        QueryOverlapInt8(adios, engineName);
+    }
+}
+
+#ifdef ADIOS2_HAVE_BP5
+TEST_F(BPQueryTest, BP5)
+{
+    std::string engineName = "BP5";
+    // Each process would write a 1x8 array and all processes would
+    // form a mpiSize * Nx 1D array
+    const std::string fname(engineName + "Query1D.bp");
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+
+    WriteFile(fname, adios, engineName);
+
+    if (mpiSize == 1)
+    {
+        QueryDoubleVar(fname, adios, engineName);
+        QueryIntVar(fname, adios, engineName);
+        QueryAllSteps(fname, adios, engineName);
+        QueryValues(fname, adios, engineName);
+        QueryOffsetBlocks(adios, engineName);
+        QueryOverlapInt8(adios, engineName);
     }
 }
+#endif
 
 //******************************************************************************
 // main
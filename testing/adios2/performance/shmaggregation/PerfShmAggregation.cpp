@@ -0,0 +1,79 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Throughput of the BP5 TwoLevelShm aggregation depending on the number of
+ * producers per node and the number of shared memory buffers.  All
+ * processes of a node write into one aggregator, so the run is dominated by
+ * the handoff of the shared memory buffers.  Run it with increasing process
+ * counts on one node, e.g.
+ *
+ *   mpiexec -n 8 PerfShmAggregation 64 10 4
+ *
+ * arguments: MB per process per step, number of steps, NumShmBuffers,
+ * optionally MaxShmSize (default 16mb) and the output path.
+ */
+#include <cstdlib>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+#include <mpi.h>
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    const size_t megabytes = (argc > 1) ? std::strtoul(argv[1], NULL, 10) : 64;
+    const size_t nsteps = (argc > 2) ? std::strtoul(argv[2], NULL, 10) : 10;
+    const std::string buffers = (argc > 3) ? argv[3] : "2";
+    const std::string shmSize = (argc > 4) ? argv[4] : "16mb";
+    const std::string path = (argc > 5) ? argv[5] : "PerfShmAggregation.bp";
+
+    const size_t nx = megabytes * 1024 * 1024 / sizeof(double);
+    std::vector<double> data(nx, static_cast<double>(rank));
+
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+    adios2::IO io = adios.DeclareIO("Output");
+    io.SetEngine("BP5");
+    io.SetParameters({{"AggregationType", "TwoLevelShm"},
+                      {"NumAggregators", "1"},
+                      {"NumShmBuffers", buffers},
+                      {"MaxShmSize", shmSize}});
+    auto var = io.DefineVariable<double>(
+        "data", {static_cast<size_t>(size) * nx},
+        {static_cast<size_t>(rank) * nx}, {nx});
+
+    adios2::Engine writer = io.Open(path, adios2::Mode::Write);
+    double seconds = 0.0;
+    for (size_t step = 0; step < nsteps; ++step)
+    {
+        writer.BeginStep();
+        writer.Put(var, data.data());
+        MPI_Barrier(MPI_COMM_WORLD);
+        const auto start = std::chrono::steady_clock::now();
+        writer.EndStep();
+        MPI_Barrier(MPI_COMM_WORLD);
+        seconds += std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+    }
+    writer.Close();
+
+    if (!rank)
+    {
+        const double total = static_cast<double>(megabytes) * size * nsteps;
+        std::cout << "producers " << size << " buffers " << buffers
+                  << " MaxShmSize " << shmSize << ": " << total / seconds
+                  << " MB/s (" << seconds << " s in EndStep)" << std::endl;
+    }
+
+    MPI_Finalize();
+    return 0;
+}